@@ -14,9 +14,27 @@ find_library(
     PATH_SUFFIXES "lib" "lib64"
     )
 
+find_library(
+    FFTW3_LIBRARY_FLOAT
+    NAMES "fftw3f"
+    PATH_SUFFIXES "lib" "lib64"
+    )
+find_library(
+    FFTW3_LIBRARY_FLOAT_OPENMP
+    NAMES "fftw3f_omp"
+    PATH_SUFFIXES "lib" "lib64"
+    )
+
 include(FindPackageHandleStandardArgs)
 find_package_handle_standard_args(FFTW3 REQUIRED_VARS FFTW3_INCLUDE_DIR FFTW3_LIBRARY)
-mark_as_advanced(FFTW3_FOUND FFTW3_INCLUDE_DIR FFTW3_LIBRARY FFTW3_LIBRARY_OPENMP)
+mark_as_advanced(
+    FFTW3_FOUND
+    FFTW3_INCLUDE_DIR
+    FFTW3_LIBRARY
+    FFTW3_LIBRARY_OPENMP
+    FFTW3_LIBRARY_FLOAT
+    FFTW3_LIBRARY_FLOAT_OPENMP
+    )
 
 if(FFTW3_FOUND)
     if(NOT TARGET FFTW3::fftw3)
@@ -37,4 +55,22 @@ if(FFTW3_FOUND)
             INTERFACE_INCLUDE_DIRECTORIES ${FFTW3_INCLUDE_DIR}
         )
     endif()
+    if(FFTW3_LIBRARY_FLOAT AND NOT TARGET FFTW3::fftw3f)
+        add_library(FFTW3::fftw3f SHARED IMPORTED)
+        set_target_properties(
+            FFTW3::fftw3f
+            PROPERTIES
+            IMPORTED_LOCATION ${FFTW3_LIBRARY_FLOAT}
+            INTERFACE_INCLUDE_DIRECTORIES ${FFTW3_INCLUDE_DIR}
+        )
+    endif()
+    if(FFTW3_LIBRARY_FLOAT_OPENMP AND NOT TARGET FFTW3::fftw3f_omp)
+        add_library(FFTW3::fftw3f_omp SHARED IMPORTED)
+        set_target_properties(
+            FFTW3::fftw3f_omp
+            PROPERTIES
+            IMPORTED_LOCATION ${FFTW3_LIBRARY_FLOAT_OPENMP}
+            INTERFACE_INCLUDE_DIRECTORIES ${FFTW3_INCLUDE_DIR}
+        )
+    endif()
 endif()
@@ -0,0 +1,68 @@
+#ifndef FLYFT_ALIGNED_ALLOCATOR_H_
+#define FLYFT_ALIGNED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace flyft
+    {
+
+//! Allocator returning memory aligned to a fixed byte boundary
+/*!
+ * The default alignment of 64 bytes matches a cache line and the widest SIMD registers.
+ */
+template<typename T, std::size_t Alignment = 64>
+class AlignedAllocator
+    {
+    public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+        {
+        using other = AlignedAllocator<U, Alignment>;
+        };
+
+    AlignedAllocator() noexcept {}
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& /*other*/) noexcept
+        {
+        }
+
+    T* allocate(std::size_t n)
+        {
+        // over allocate, then stash the original pointer just before the aligned block
+        void* raw = ::operator new(n * sizeof(T) + Alignment + sizeof(void*));
+        std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+        addr = (addr + Alignment - 1) & ~static_cast<std::uintptr_t>(Alignment - 1);
+        reinterpret_cast<void**>(addr)[-1] = raw;
+        return reinterpret_cast<T*>(addr);
+        }
+
+    void deallocate(T* p, std::size_t /*n*/) noexcept
+        {
+        ::operator delete(reinterpret_cast<void**>(p)[-1]);
+        }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept
+        {
+        return true;
+        }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept
+        {
+        return false;
+        }
+    };
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+    } // namespace flyft
+
+#endif // FLYFT_ALIGNED_ALLOCATOR_H_
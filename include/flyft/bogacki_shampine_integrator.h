@@ -0,0 +1,24 @@
+#ifndef FLYFT_BOGACKI_SHAMPINE_INTEGRATOR_H_
+#define FLYFT_BOGACKI_SHAMPINE_INTEGRATOR_H_
+
+#include "flyft/embedded_runge_kutta_integrator.h"
+
+namespace flyft
+    {
+
+//! Third-order Bogacki-Shampine integrator with an embedded second-order error estimate
+class BogackiShampineIntegrator : public EmbeddedRungeKuttaIntegrator
+    {
+    public:
+    BogackiShampineIntegrator(double timestep);
+
+    protected:
+    int getLocalErrorExponent() const override
+        {
+        return 3;
+        }
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_BOGACKI_SHAMPINE_INTEGRATOR_H_
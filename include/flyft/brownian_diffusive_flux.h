@@ -13,11 +13,17 @@ namespace flyft
 class BrownianDiffusiveFlux : public Flux
     {
     public:
+    BrownianDiffusiveFlux();
+
+    void applyExplicitUpdate(std::shared_ptr<GrandPotential> grand,
+                             std::shared_ptr<State> state,
+                             double timestep) override;
+
     TypeMap<double>& getDiffusivities();
     const TypeMap<double>& getDiffusivities() const;
 
     protected:
-    void compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override;
+    void _compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override;
     int determineBufferShape(std::shared_ptr<State> state, const std::string& type) override;
 
     private:
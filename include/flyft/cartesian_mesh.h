@@ -6,7 +6,7 @@
 namespace flyft
     {
 
-class CartesianMesh : public Mesh
+class CartesianMesh final : public Mesh
     {
     public:
     CartesianMesh(double lower_bound,
@@ -21,11 +21,50 @@ class CartesianMesh : public Mesh
     double volume(int i) const override;
     double gradient(int idx, double f_lo, double f_hi) const override;
 
+    // nonvirtual versions of the Mesh methods that can be inlined for this geometry
+    double gradient(int idx, const DataView<const FieldValue>& f) const;
+    double gradient(int idx, const DataView<FieldValue>& f) const;
+
+    //! Smallest shape at least as large as shape that is fast to Fourier transform
+    static int fastShape(int shape);
+
     protected:
     std::shared_ptr<Mesh> clone() const override;
 
     private:
     double area_; //<! Cross sectional area
     };
+
+// geometry is defined inline so that kernels templated on the mesh type can inline it
+inline double CartesianMesh::area(int /*i*/) const
+    {
+    return area_;
+    }
+
+inline double CartesianMesh::volume() const
+    {
+    return area_ * L();
+    }
+
+inline double CartesianMesh::volume(int /*i*/) const
+    {
+    return area_ * step_;
+    }
+
+inline double CartesianMesh::gradient(int /*i*/, double f_lo, double f_hi) const
+    {
+    return (f_hi - f_lo) / step_;
+    }
+
+inline double CartesianMesh::gradient(int idx, const DataView<const FieldValue>& f) const
+    {
+    return (isReflectingEdge(idx)) ? 0. : gradient(idx, f(idx - 1), f(idx));
+    }
+
+inline double CartesianMesh::gradient(int idx, const DataView<FieldValue>& f) const
+    {
+    return (isReflectingEdge(idx)) ? 0. : gradient(idx, f(idx - 1), f(idx));
+    }
+
     } // namespace flyft
 #endif // FLYFT_CARTESIAN_MESH_H_
@@ -7,9 +7,11 @@
 #include <mpi.h>
 #endif // FLYFT_MPI
 
+#include <algorithm>
 #include <complex>
 #include <cstdint>
 #include <type_traits>
+#include <vector>
 
 namespace flyft
     {
@@ -73,15 +75,31 @@ class Communicator
         return tmp;
         }
 
-    private:
+    //! Gather the same number of values from every rank, ordered by rank
+    template<typename T>
+    std::vector<T> allgather(const std::vector<T>& values) const
+        {
+        std::vector<T> tmp(values.size() * size_);
 #ifdef FLYFT_MPI
-    MPI_Comm comm_;
-#endif
-    int size_;
-    int rank_;
-    int root_;
+        if (size_ > 1)
+            {
+            const int count = static_cast<int>(values.size());
+            MPI_Allgather(values.data(),
+                          count,
+                          mpi_type<T>(),
+                          tmp.data(),
+                          count,
+                          mpi_type<T>(),
+                          comm_);
+            return tmp;
+            }
+#endif // FLYFT_MPI
+        std::copy(values.begin(), values.end(), tmp.begin());
+        return tmp;
+        }
 
 #ifdef FLYFT_MPI
+    //! MPI datatype matching a C++ type
     // https://gist.github.com/2b-t/50d85115db8b12ed263f8231abf07fa2
     template<typename T>
     constexpr MPI_Datatype mpi_type() const noexcept
@@ -198,6 +216,14 @@ class Communicator
         return type;
         }
 #endif // FLYFT_MPI
+
+    private:
+#ifdef FLYFT_MPI
+    MPI_Comm comm_;
+#endif
+    int size_;
+    int rank_;
+    int root_;
     };
 
     } // namespace flyft
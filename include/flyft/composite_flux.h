@@ -15,8 +15,15 @@ class CompositeFlux : public Flux, public CompositeMixin<Flux>
     {
     public:
     using CompositeMixin<Flux>::CompositeMixin;
-    void compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override;
     void requestFluxBuffer(const std::string& type, int buffer_request) override;
+
+    bool addObject(std::shared_ptr<Flux> object);
+    bool removeObject(std::shared_ptr<Flux> object);
+    void clearObjects();
+
+    protected:
+    bool setup(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override;
+    void _compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override;
     };
 
     } // namespace flyft
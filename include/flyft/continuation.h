@@ -0,0 +1,73 @@
+#ifndef FLYFT_CONTINUATION_H_
+#define FLYFT_CONTINUATION_H_
+
+#include "flyft/field.h"
+#include "flyft/grand_potential.h"
+#include "flyft/solver.h"
+#include "flyft/state.h"
+#include "flyft/tracked_object.h"
+#include "flyft/type_map.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace flyft
+    {
+
+//! Solve a sequence of states along a control variable
+/*!
+ * The control variable is the constraint of one type in the grand potential, or the time of the
+ * state if no type is set so that any time-dependent parameter follows it. Before each solve, the
+ * initial guess for the densities is extrapolated from the previously converged solutions by a
+ * polynomial through the last one (secant) or two (quadratic) of them and clamped to be
+ * nonnegative. The stored solutions are discarded if a different grand potential or state is
+ * solved.
+ */
+class Continuation
+    {
+    public:
+    enum class Predictor
+    {
+        none,
+        secant,
+        quadratic
+    };
+
+    Continuation(std::shared_ptr<Solver> solver, Predictor predictor);
+
+    bool solve(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state, double value);
+    void reset();
+
+    std::shared_ptr<Solver> getSolver();
+    void setSolver(std::shared_ptr<Solver> solver);
+
+    Predictor getPredictor() const;
+    void setPredictor(Predictor predictor);
+
+    std::string getControlType() const;
+    void setControlType(const std::string& type);
+
+    int getNumSolutions() const;
+
+    private:
+    struct Solution
+        {
+        double value;
+        TypeMap<std::shared_ptr<Field>> fields;
+        };
+
+    std::shared_ptr<Solver> solver_;
+    Predictor predictor_;
+    std::string control_type_;
+    std::deque<Solution> solutions_;
+    TrackedObject::Identifier grand_id_;
+    TrackedObject::Identifier state_id_;
+
+    void predict(std::shared_ptr<State> state, double value) const;
+    void store(std::shared_ptr<State> state, double value);
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_CONTINUATION_H_
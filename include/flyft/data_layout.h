@@ -1,23 +1,43 @@
 #ifndef FLYFT_DATA_LAYOUT_H_
 #define FLYFT_DATA_LAYOUT_H_
 
-#include <iterator>
-#include <type_traits>
-
 namespace flyft
     {
+//! Contiguous identity layout
+/*!
+ * All methods are constexpr and defined inline so that indexing through the layout compiles down
+ * to a plain offset.
+ */
 class DataLayout
     {
     public:
-    DataLayout();
-    explicit DataLayout(int shape_);
+    constexpr DataLayout() : shape_(0) {}
+    constexpr explicit DataLayout(int shape) : shape_(shape) {}
+
+    constexpr int operator()(int idx) const
+        {
+        return idx;
+        }
+
+    constexpr int shape() const
+        {
+        return shape_;
+        }
+
+    constexpr int size() const
+        {
+        return shape();
+        }
 
-    int operator()(int idx) const;
-    int shape() const;
-    int size() const;
+    constexpr bool operator==(const DataLayout& other) const
+        {
+        return (shape_ == other.shape_);
+        }
 
-    bool operator==(const DataLayout& other) const;
-    bool operator!=(const DataLayout& other) const;
+    constexpr bool operator!=(const DataLayout& other) const
+        {
+        return !(*this == other);
+        }
 
     private:
     int shape_;
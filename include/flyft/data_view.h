@@ -3,6 +3,10 @@
 
 #include "flyft/data_layout.h"
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
 namespace flyft
     {
 
@@ -14,65 +18,105 @@ class DataView
     using pointer = value_type*;
     using reference = value_type&;
 
+    //! Random-access iterator over the contiguous elements of a view
     class Iterator
         {
         public:
-        using iterator_category = std::bidirectional_iterator_tag;
-        using difference_type = int;
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = std::ptrdiff_t;
         using value_type = DataView::value_type;
         using pointer = DataView::pointer;
         using reference = DataView::reference;
 
-        Iterator() : Iterator(DataView()) {}
+        Iterator() : ptr_(nullptr) {}
 
         explicit Iterator(const DataView& view) : Iterator(view, 0) {}
 
-        Iterator(const DataView& view, int current) : view_(view), current_(current) {}
+        Iterator(const DataView& view, int current) : ptr_(view.data() + current) {}
 
         reference operator*() const
             {
-            return view_(current_);
+            return *ptr_;
             }
 
         pointer operator->() const
             {
-            return get();
+            return ptr_;
+            }
+
+        reference operator[](difference_type n) const
+            {
+            return ptr_[n];
             }
 
         pointer get() const
             {
-            return &view_(current_);
+            return ptr_;
             }
 
         Iterator& operator++()
             {
-            ++current_;
+            ++ptr_;
             return *this;
             }
 
         Iterator operator++(int)
             {
             Iterator tmp(*this);
-            ++current_;
+            ++ptr_;
             return tmp;
             }
 
         Iterator& operator--()
             {
-            --current_;
+            --ptr_;
             return *this;
             }
 
         Iterator operator--(int)
             {
             Iterator tmp(*this);
-            --current_;
+            --ptr_;
             return tmp;
             }
 
+        Iterator& operator+=(difference_type n)
+            {
+            ptr_ += n;
+            return *this;
+            }
+
+        Iterator& operator-=(difference_type n)
+            {
+            ptr_ -= n;
+            return *this;
+            }
+
+        Iterator operator+(difference_type n) const
+            {
+            Iterator tmp(*this);
+            return (tmp += n);
+            }
+
+        friend Iterator operator+(difference_type n, const Iterator& it)
+            {
+            return it + n;
+            }
+
+        Iterator operator-(difference_type n) const
+            {
+            Iterator tmp(*this);
+            return (tmp -= n);
+            }
+
+        difference_type operator-(const Iterator& other) const
+            {
+            return ptr_ - other.ptr_;
+            }
+
         bool operator==(const Iterator& other) const
             {
-            return (get() == other.get());
+            return (ptr_ == other.ptr_);
             }
 
         bool operator!=(const Iterator& other) const
@@ -80,9 +124,28 @@ class DataView
             return !(*this == other);
             }
 
+        bool operator<(const Iterator& other) const
+            {
+            return (ptr_ < other.ptr_);
+            }
+
+        bool operator>(const Iterator& other) const
+            {
+            return (other < *this);
+            }
+
+        bool operator<=(const Iterator& other) const
+            {
+            return !(other < *this);
+            }
+
+        bool operator>=(const Iterator& other) const
+            {
+            return !(*this < other);
+            }
+
         private:
-        DataView view_;
-        int current_;
+        pointer ptr_;
         };
 
     DataView() : DataView(nullptr, DataLayout()) {}
@@ -99,6 +162,15 @@ class DataView
         return data_[layout_(start_ + idx)];
         }
 
+    //! Raw pointer to the first element of the view
+    /*!
+     * The layout is contiguous, so the view can be traversed as the span [data(), data()+size()).
+     */
+    pointer data() const
+        {
+        return data_ + layout_(start_);
+        }
+
     int shape() const
         {
         return end_ - start_;
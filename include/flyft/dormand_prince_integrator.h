@@ -0,0 +1,24 @@
+#ifndef FLYFT_DORMAND_PRINCE_INTEGRATOR_H_
+#define FLYFT_DORMAND_PRINCE_INTEGRATOR_H_
+
+#include "flyft/embedded_runge_kutta_integrator.h"
+
+namespace flyft
+    {
+
+//! Fifth-order Dormand-Prince integrator with an embedded fourth-order error estimate
+class DormandPrinceIntegrator : public EmbeddedRungeKuttaIntegrator
+    {
+    public:
+    DormandPrinceIntegrator(double timestep);
+
+    protected:
+    int getLocalErrorExponent() const override
+        {
+        return 5;
+        }
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_DORMAND_PRINCE_INTEGRATOR_H_
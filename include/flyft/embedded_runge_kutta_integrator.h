@@ -0,0 +1,70 @@
+#ifndef FLYFT_EMBEDDED_RUNGE_KUTTA_INTEGRATOR_H_
+#define FLYFT_EMBEDDED_RUNGE_KUTTA_INTEGRATOR_H_
+
+#include "flyft/field.h"
+#include "flyft/flux.h"
+#include "flyft/grand_potential.h"
+#include "flyft/integrator.h"
+#include "flyft/state.h"
+#include "flyft/type_map.h"
+
+#include <memory>
+#include <vector>
+
+namespace flyft
+    {
+
+//! Explicit Runge-Kutta integrator with an embedded error estimate
+/*!
+ * The step is defined by a Butcher tableau with weights b for the solution and weights b_hat for
+ * the embedded lower-order solution. The difference between the two gives the local error, so
+ * adaptive steps require no extra flux evaluations. The step size is set by a PI controller.
+ * If the last stage is evaluated at the solution (first same as last), its rate is reused as the
+ * first stage of the next step. Storage for the stages is allocated once and reused.
+ */
+class EmbeddedRungeKuttaIntegrator : public Integrator
+    {
+    public:
+    bool advance(std::shared_ptr<Flux> flux,
+                 std::shared_ptr<GrandPotential> grand,
+                 std::shared_ptr<State> state,
+                 double time) override;
+
+    protected:
+    EmbeddedRungeKuttaIntegrator(double timestep,
+                                 const std::vector<std::vector<double>>& a,
+                                 const std::vector<double>& b,
+                                 const std::vector<double>& b_hat,
+                                 const std::vector<double>& c);
+
+    void step(std::shared_ptr<Flux> flux,
+              std::shared_ptr<GrandPotential> grand,
+              std::shared_ptr<State> state,
+              double timestep) override;
+
+    private:
+    std::vector<std::vector<double>> a_;
+    std::vector<double> b_;
+    std::vector<double> b_err_;
+    std::vector<double> c_;
+    bool fsal_;
+
+    std::shared_ptr<State> stage_state_;
+    std::vector<TypeMap<std::shared_ptr<Field>>> rates_;
+    bool has_first_rate_;
+
+    void prepareStages(std::shared_ptr<State> state);
+    double attemptStep(std::shared_ptr<Flux> flux,
+                       std::shared_ptr<GrandPotential> grand,
+                       std::shared_ptr<State> state,
+                       double timestep);
+    void acceptStep(std::shared_ptr<State> state, double timestep);
+    void computeRate(std::shared_ptr<Flux> flux,
+                     std::shared_ptr<GrandPotential> grand,
+                     std::shared_ptr<State> state,
+                     TypeMap<std::shared_ptr<Field>>& rate);
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_EMBEDDED_RUNGE_KUTTA_INTEGRATOR_H_
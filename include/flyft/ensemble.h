@@ -0,0 +1,50 @@
+#ifndef FLYFT_ENSEMBLE_H_
+#define FLYFT_ENSEMBLE_H_
+
+#include "flyft/grand_potential.h"
+#include "flyft/solver.h"
+#include "flyft/state.h"
+
+#include <memory>
+#include <vector>
+
+namespace flyft
+    {
+
+//! Independent systems that are solved together
+/*!
+ * Each system is a grand potential and a state, and the systems are distributed across OpenMP
+ * threads in a single call. The systems may share a mesh, but they are only solved concurrently if
+ * they do not share grand potentials or functionals, including functionals inside composites, and
+ * every state is on a single rank. Otherwise, they are solved one after another. The solver is
+ * shared by all systems, so it must not hold any per-system data.
+ */
+class Ensemble
+    {
+    public:
+    Ensemble();
+
+    int size() const;
+
+    void addSystem(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state);
+    void removeSystem(int index);
+    void clearSystems();
+
+    std::shared_ptr<GrandPotential> getGrandPotential(int index);
+    std::shared_ptr<State> getState(int index);
+
+    std::vector<bool> solve(std::shared_ptr<Solver> solver);
+
+    //! Whether the systems are independent enough to be solved concurrently
+    bool canSolveConcurrently();
+
+    private:
+    std::vector<std::shared_ptr<GrandPotential>> grands_;
+    std::vector<std::shared_ptr<State>> states_;
+
+    void checkIndex(int index) const;
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_ENSEMBLE_H_
@@ -21,6 +21,12 @@ class ExplicitEulerIntegrator : public Integrator
               std::shared_ptr<State> state,
               double timestep) override;
 
+    void stepInto(std::shared_ptr<Flux> flux,
+                  std::shared_ptr<GrandPotential> grand,
+                  std::shared_ptr<State> state,
+                  std::shared_ptr<State> next_state,
+                  double timestep) override;
+
     int getLocalErrorExponent() const override
         {
         return 2;
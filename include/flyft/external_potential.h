@@ -8,6 +8,7 @@
 #include <cmath>
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace flyft
     {
@@ -17,6 +18,21 @@ class ExternalPotential : public Functional
     public:
     ExternalPotential();
 
+    //! Local points [first, last) outside which the potential is +infinity
+    /*!
+     * The range is found whenever the potentials are evaluated, so it is valid once the potential
+     * has been computed for the current state. The density must be zero outside the range, so
+     * kernels can skip those points. Points inside the range may still have infinite potential.
+     */
+    std::pair<int, int> getActiveRange(const std::string& type) const;
+
+    //! Boltzmann factor exp(-V) of the potential on the local points
+    /*!
+     * The factor is evaluated whenever the potentials are, so it is cached between computes that
+     * do not change the potential. It is zero where the potential is +infinity.
+     */
+    std::shared_ptr<const Field> getBoltzmannFactor(const std::string& type) const;
+
     protected:
     bool setup(std::shared_ptr<State> state, bool compute_value) override;
     void _compute(std::shared_ptr<State> state, bool compute_value) override;
@@ -25,6 +41,11 @@ class ExternalPotential : public Functional
     private:
     bool compute_potentials_;
     std::weak_ptr<const Mesh> compute_potentials_mesh_;
+    TypeMap<std::pair<int, int>> active_ranges_;        //!< Active range per type
+    TypeMap<std::shared_ptr<Field>> boltzmann_factors_; //!< Boltzmann factor per type
+
+    void computeActiveRanges(std::shared_ptr<State> state);
+    void computeBoltzmannFactors(std::shared_ptr<State> state);
     };
 
     } // namespace flyft
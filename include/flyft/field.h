@@ -151,6 +151,25 @@ class GenericField : public TrackedObject
             }
         }
 
+    //! Exchange data with another field without copying
+    /*!
+     * Only the contents are exchanged, so each field keeps its identity and any views of either
+     * field are invalidated.
+     */
+    void swap(GenericField& other)
+        {
+        if (this == &other)
+            {
+            return;
+            }
+        std::swap(data_, other.data_);
+        std::swap(shape_, other.shape_);
+        std::swap(buffer_shape_, other.buffer_shape_);
+        std::swap(layout_, other.layout_);
+        token_.stageAndCommit();
+        other.token_.stageAndCommit();
+        }
+
     private:
     T* data_;
     int shape_;
@@ -158,8 +177,15 @@ class GenericField : public TrackedObject
     DataLayout layout_;
     };
 
-using Field = GenericField<double>;
-using ComplexField = GenericField<std::complex<double>>;
+//! Type of the values stored in fields; arithmetic and reductions are done in double precision
+#ifdef FLYFT_SINGLE_PRECISION
+using FieldValue = float;
+#else
+using FieldValue = double;
+#endif // FLYFT_SINGLE_PRECISION
+
+using Field = GenericField<FieldValue>;
+using ComplexField = GenericField<std::complex<FieldValue>>;
 
     } // namespace flyft
 
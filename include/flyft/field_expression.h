@@ -0,0 +1,387 @@
+#ifndef FLYFT_FIELD_EXPRESSION_H_
+#define FLYFT_FIELD_EXPRESSION_H_
+
+#include "flyft/boundary_type.h"
+#include "flyft/data_view.h"
+#include "flyft/mesh.h"
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace flyft
+    {
+
+//! Tag base for lazily evaluated field expressions
+/*!
+ * An expression is any object with a const operator()(int idx) returning the value at a mesh
+ * point. Expressions are built up with the arithmetic operators, exp, log, and the mesh stencils,
+ * then evaluated pointwise in a single pass by assign. Operands are stored by value, so views and
+ * scalars are captured when the expression is built.
+ */
+class FieldExpressionBase
+    {
+    };
+
+template<typename T>
+class ViewExpression : public FieldExpressionBase
+    {
+    public:
+    explicit ViewExpression(const DataView<T>& view) : view_(view) {}
+
+    double operator()(int idx) const
+        {
+        return view_(idx);
+        }
+
+    private:
+    DataView<T> view_;
+    };
+
+class ScalarExpression : public FieldExpressionBase
+    {
+    public:
+    explicit ScalarExpression(double value) : value_(value) {}
+
+    double operator()(int /*idx*/) const
+        {
+        return value_;
+        }
+
+    private:
+    double value_;
+    };
+
+//! Sum of a variable number of views
+class SumExpression : public FieldExpressionBase
+    {
+    public:
+    explicit SumExpression(const std::vector<DataView<const FieldValue>>& views) : views_(views) {}
+
+    double operator()(int idx) const
+        {
+        double value = 0.;
+        for (const auto& v : views_)
+            {
+            value += v(idx);
+            }
+        return value;
+        }
+
+    private:
+    std::vector<DataView<const FieldValue>> views_;
+    };
+
+template<class L, class R, class Op>
+class BinaryExpression : public FieldExpressionBase
+    {
+    public:
+    BinaryExpression(const L& left, const R& right) : left_(left), right_(right) {}
+
+    double operator()(int idx) const
+        {
+        return Op::apply(left_(idx), right_(idx));
+        }
+
+    private:
+    L left_;
+    R right_;
+    };
+
+template<class E, class Op>
+class UnaryExpression : public FieldExpressionBase
+    {
+    public:
+    explicit UnaryExpression(const E& expr) : expr_(expr) {}
+
+    double operator()(int idx) const
+        {
+        return Op::apply(expr_(idx));
+        }
+
+    private:
+    E expr_;
+    };
+
+//! Gradient on the lower edge of a bin, zero at reflecting boundaries
+template<class E>
+class GradientExpression : public FieldExpressionBase
+    {
+    public:
+    GradientExpression(const Mesh* mesh, const E& expr)
+        : mesh_(mesh), expr_(expr),
+          reflect_lower_(mesh->lower_boundary_condition() == BoundaryType::reflect),
+          reflect_upper_(mesh->upper_boundary_condition() == BoundaryType::reflect)
+        {
+        }
+
+    double operator()(int idx) const
+        {
+        if ((idx == 0 && reflect_lower_) || (idx == mesh_->shape() - 1 && reflect_upper_))
+            {
+            return 0;
+            }
+        else
+            {
+            return mesh_->gradient(idx, expr_(idx - 1), expr_(idx));
+            }
+        }
+
+    private:
+    const Mesh* mesh_;
+    E expr_;
+    bool reflect_lower_;
+    bool reflect_upper_;
+    };
+
+//! Net flux into a bin through its surfaces
+template<class E>
+class SurfaceIntegralExpression : public FieldExpressionBase
+    {
+    public:
+    SurfaceIntegralExpression(const Mesh* mesh, const E& expr) : mesh_(mesh), expr_(expr) {}
+
+    double operator()(int idx) const
+        {
+        return mesh_->integrateSurface(idx, expr_(idx), expr_(idx + 1));
+        }
+
+    private:
+    const Mesh* mesh_;
+    E expr_;
+    };
+
+//! Bin volumes from the cached mesh table, valid on the interior points only
+class VolumeExpression : public FieldExpressionBase
+    {
+    public:
+    explicit VolumeExpression(const double* volumes) : volumes_(volumes) {}
+
+    double operator()(int idx) const
+        {
+        return volumes_[idx];
+        }
+
+    private:
+    const double* volumes_;
+    };
+
+struct PlusOperation
+    {
+    static double apply(double a, double b)
+        {
+        return a + b;
+        }
+    };
+
+struct MinusOperation
+    {
+    static double apply(double a, double b)
+        {
+        return a - b;
+        }
+    };
+
+struct MultipliesOperation
+    {
+    static double apply(double a, double b)
+        {
+        return a * b;
+        }
+    };
+
+struct DividesOperation
+    {
+    static double apply(double a, double b)
+        {
+        return a / b;
+        }
+    };
+
+struct NegateOperation
+    {
+    static double apply(double a)
+        {
+        return -a;
+        }
+    };
+
+struct ExpOperation
+    {
+    static double apply(double a)
+        {
+        return std::exp(a);
+        }
+    };
+
+struct LogOperation
+    {
+    static double apply(double a)
+        {
+        return std::log(a);
+        }
+    };
+
+//! Map an operand (expression, view, or scalar) to its expression type
+template<typename T, typename Enable = void>
+struct ExpressionOperand
+    {
+    static constexpr bool value = false;
+    };
+
+template<typename T>
+struct ExpressionOperand<
+    T,
+    typename std::enable_if<std::is_base_of<FieldExpressionBase, T>::value>::type>
+    {
+    static constexpr bool value = true;
+    using type = T;
+    static const T& make(const T& expr)
+        {
+        return expr;
+        }
+    };
+
+template<typename T>
+struct ExpressionOperand<DataView<T>>
+    {
+    static constexpr bool value = true;
+    using type = ViewExpression<T>;
+    static type make(const DataView<T>& view)
+        {
+        return type(view);
+        }
+    };
+
+template<typename T>
+struct ExpressionOperand<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    {
+    static constexpr bool value = false;
+    using type = ScalarExpression;
+    static type make(T value)
+        {
+        return type(static_cast<double>(value));
+        }
+    };
+
+template<typename L, typename R>
+using BinaryExpressionEnable = typename std::enable_if<
+    (ExpressionOperand<L>::value
+     && (ExpressionOperand<R>::value || std::is_arithmetic<R>::value))
+    || (std::is_arithmetic<L>::value && ExpressionOperand<R>::value)>::type;
+
+template<typename L, typename R, class Op>
+using BinaryExpressionType = BinaryExpression<typename ExpressionOperand<L>::type,
+                                              typename ExpressionOperand<R>::type,
+                                              Op>;
+
+template<typename L, typename R, typename = BinaryExpressionEnable<L, R>>
+BinaryExpressionType<L, R, PlusOperation> operator+(const L& left, const R& right)
+    {
+    return BinaryExpressionType<L, R, PlusOperation>(ExpressionOperand<L>::make(left),
+                                                     ExpressionOperand<R>::make(right));
+    }
+
+template<typename L, typename R, typename = BinaryExpressionEnable<L, R>>
+BinaryExpressionType<L, R, MinusOperation> operator-(const L& left, const R& right)
+    {
+    return BinaryExpressionType<L, R, MinusOperation>(ExpressionOperand<L>::make(left),
+                                                      ExpressionOperand<R>::make(right));
+    }
+
+template<typename L, typename R, typename = BinaryExpressionEnable<L, R>>
+BinaryExpressionType<L, R, MultipliesOperation> operator*(const L& left, const R& right)
+    {
+    return BinaryExpressionType<L, R, MultipliesOperation>(ExpressionOperand<L>::make(left),
+                                                           ExpressionOperand<R>::make(right));
+    }
+
+template<typename L, typename R, typename = BinaryExpressionEnable<L, R>>
+BinaryExpressionType<L, R, DividesOperation> operator/(const L& left, const R& right)
+    {
+    return BinaryExpressionType<L, R, DividesOperation>(ExpressionOperand<L>::make(left),
+                                                        ExpressionOperand<R>::make(right));
+    }
+
+template<typename E, typename = typename std::enable_if<ExpressionOperand<E>::value>::type>
+UnaryExpression<typename ExpressionOperand<E>::type, NegateOperation> operator-(const E& expr)
+    {
+    return UnaryExpression<typename ExpressionOperand<E>::type, NegateOperation>(
+        ExpressionOperand<E>::make(expr));
+    }
+
+template<typename E, typename = typename std::enable_if<ExpressionOperand<E>::value>::type>
+UnaryExpression<typename ExpressionOperand<E>::type, ExpOperation> exp(const E& expr)
+    {
+    return UnaryExpression<typename ExpressionOperand<E>::type, ExpOperation>(
+        ExpressionOperand<E>::make(expr));
+    }
+
+template<typename E, typename = typename std::enable_if<ExpressionOperand<E>::value>::type>
+UnaryExpression<typename ExpressionOperand<E>::type, LogOperation> log(const E& expr)
+    {
+    return UnaryExpression<typename ExpressionOperand<E>::type, LogOperation>(
+        ExpressionOperand<E>::make(expr));
+    }
+
+inline SumExpression sum(const std::vector<DataView<const FieldValue>>& views)
+    {
+    return SumExpression(views);
+    }
+
+template<typename E, typename = typename std::enable_if<ExpressionOperand<E>::value>::type>
+GradientExpression<typename ExpressionOperand<E>::type> gradient(const Mesh* mesh, const E& expr)
+    {
+    return GradientExpression<typename ExpressionOperand<E>::type>(
+        mesh,
+        ExpressionOperand<E>::make(expr));
+    }
+
+template<typename E, typename = typename std::enable_if<ExpressionOperand<E>::value>::type>
+SurfaceIntegralExpression<typename ExpressionOperand<E>::type> integrateSurface(const Mesh* mesh,
+                                                                                const E& expr)
+    {
+    return SurfaceIntegralExpression<typename ExpressionOperand<E>::type>(
+        mesh,
+        ExpressionOperand<E>::make(expr));
+    }
+
+inline VolumeExpression volume(const Mesh* mesh)
+    {
+    return VolumeExpression(mesh->volumes());
+    }
+
+inline VolumeExpression inverseVolume(const Mesh* mesh)
+    {
+    return VolumeExpression(mesh->inverse_volumes());
+    }
+
+//! Evaluate an expression into a view on points [first, last)
+/*!
+ * The expression is evaluated pointwise, so the output view may also appear in the expression as
+ * long as it is only read at the same point.
+ */
+template<typename T, class E>
+void assign(const DataView<T>& out, const E& expr, int first, int last)
+    {
+    const auto e = ExpressionOperand<E>::make(expr);
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(first, last) shared(out, e)
+#endif
+    for (int idx = first; idx < last; ++idx)
+        {
+        out(idx) = e(idx);
+        }
+    }
+
+//! Evaluate an expression into every point of a view
+template<typename T, class E>
+void assign(const DataView<T>& out, const E& expr)
+    {
+    assign(out, expr, 0, out.size());
+    }
+
+    } // namespace flyft
+
+#endif // FLYFT_FIELD_EXPRESSION_H_
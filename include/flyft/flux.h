@@ -4,6 +4,7 @@
 #include "flyft/field.h"
 #include "flyft/grand_potential.h"
 #include "flyft/state.h"
+#include "flyft/tracked_object.h"
 #include "flyft/type_map.h"
 
 #include <memory>
@@ -12,7 +13,7 @@
 namespace flyft
     {
 
-class Flux
+class Flux : public TrackedObject
     {
     public:
     Flux();
@@ -24,7 +25,12 @@ class Flux
     Flux& operator=(const Flux&) = delete;
     Flux& operator=(Flux&&) = delete;
 
-    virtual void compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) = 0;
+    virtual Token compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state);
+
+    //! Advance the densities by one explicit Euler step of the divergence of the flux
+    virtual void applyExplicitUpdate(std::shared_ptr<GrandPotential> grand,
+                                     std::shared_ptr<State> state,
+                                     double timestep);
 
     const TypeMap<std::shared_ptr<Field>>& getFluxes();
     std::shared_ptr<Field> getFlux(const std::string& type);
@@ -36,11 +42,22 @@ class Flux
     protected:
     TypeMap<std::shared_ptr<Field>> fluxes_;
     TypeMap<int> buffer_requests_;
+    Dependencies compute_depends_;
+    Token compute_token_;
+    Token compute_state_token_;
 
-    virtual void setup(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state);
+    virtual bool setup(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state);
+    virtual void _compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) = 0;
+    virtual Token finalize(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state);
 
     virtual bool validateConstraints(std::shared_ptr<GrandPotential> grand,
                                      std::shared_ptr<State> state) const;
+
+    private:
+    std::shared_ptr<Functional> compute_excess_;
+    std::shared_ptr<Functional> compute_external_;
+
+    void trackFunctional(std::shared_ptr<Functional>& current, std::shared_ptr<Functional> object);
     };
 
     } // namespace flyft
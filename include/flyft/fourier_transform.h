@@ -4,6 +4,7 @@
 #include "flyft/cartesian_mesh.h"
 #include "flyft/data_layout.h"
 #include "flyft/data_view.h"
+#include "flyft/field.h"
 
 // need to include <complex> before <fftw3.h>
 #include <complex>
@@ -13,29 +14,56 @@
 namespace flyft
     {
 
+//! Fourier transform of real data on a uniform mesh
+/*!
+ * Periodic data are transformed to complex coefficients. Data that are even or odd about the
+ * ends of the mesh, halfway between the first or last point and its image, are instead expanded
+ * in cosine or sine series with real coefficients using the FFTW real-to-real transforms. These
+ * need no buffer around the data to represent the symmetry and do not compute the imaginary
+ * parts.
+ *
+ * The transform can also pad the data to the next size that FFTW transforms quickly. The padding
+ * continues the data smoothly past the upper end, and the views of the real data still have the
+ * requested shape, but the wavevectors are those of the padded length. Padding is only
+ * appropriate when the data have a buffer at the upper end at least as wide as the range of
+ * whatever is computed from the coefficients.
+ */
 class FourierTransform
     {
     public:
+    //! Symmetry of the real data about the ends of the mesh
+    enum class Symmetry
+    {
+        periodic, //!< Periodic (complex coefficients)
+        even,     //!< Even about both ends (cosines, REDFT10 / REDFT01)
+        odd,      //!< Odd about both ends (sines, RODFT10 / RODFT01)
+        odd_even, //!< Odd about the lower end and even about the upper end (sines, RODFT11)
+        even_odd  //!< Even about the lower end and odd about the upper end (cosines, REDFT11)
+    };
+
     class Wavevectors
         {
         public:
         Wavevectors() = delete;
-        Wavevectors(double L, int N);
+        Wavevectors(double L, int N, Symmetry symmetry);
         double operator()(int i) const;
         int shape() const;
 
         private:
-        double step_; //!< Spacing between mesh points
-        int shape_;   //!< Shape of underlying mesh
+        double step_;   //!< Spacing between wavevectors
+        double offset_; //!< Index of the first wavevector
+        int shape_;     //!< Number of wavevectors
         };
 
-    using RealView = DataView<double>;
-    using ConstantRealView = DataView<const double>;
-    using ReciprocalView = DataView<std::complex<double>>;
-    using ConstantReciprocalView = DataView<const std::complex<double>>;
+    using RealView = DataView<FieldValue>;
+    using ConstantRealView = DataView<const FieldValue>;
+    using ReciprocalView = DataView<std::complex<FieldValue>>;
+    using ConstantReciprocalView = DataView<const std::complex<FieldValue>>;
 
     FourierTransform() = delete;
     FourierTransform(double L, int shape);
+    FourierTransform(double L, int shape, Symmetry symmetry);
+    FourierTransform(double L, int shape, Symmetry symmetry, bool pad);
     ~FourierTransform();
 
     // noncopyable / nonmovable
@@ -62,20 +90,41 @@ class FourierTransform
     void setReciprocalData(const ReciprocalView& data);
     void setReciprocalData(const ConstantReciprocalView& data);
 
+    //! Real coefficients of the cosine or sine series for data that are not periodic
+    RealView view_coefficients() const;
+    ConstantRealView const_view_coefficients() const;
+    void setCoefficients(const RealView& data);
+    void setCoefficients(const ConstantRealView& data);
+
     Space getActiveSpace() const;
 
     double getL() const;
     int getN() const;
+    int getPaddedN() const;
+    Symmetry getSymmetry() const;
     const Wavevectors& getWavevectors() const;
 
+    //! Smallest size at least N that has no prime factors larger than 7
+    static int fastSize(int N);
+
     private:
+#ifdef FLYFT_SINGLE_PRECISION
+    using Plan = fftwf_plan;
+#else
+    using Plan = fftw_plan;
+#endif // FLYFT_SINGLE_PRECISION
+
     double L_;
     int N_;
+    int padded_N_;
+    Symmetry symmetry_;
     Wavevectors kmesh_;
     Space space_;
-    double* data_;
-    fftw_plan r2c_plan_;
-    fftw_plan c2r_plan_;
+    FieldValue* data_;
+    Plan forward_plan_;
+    Plan backward_plan_;
+
+    void padRealData();
     };
 
     } // namespace flyft
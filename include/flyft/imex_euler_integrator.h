@@ -0,0 +1,68 @@
+#ifndef FLYFT_IMEX_EULER_INTEGRATOR_H_
+#define FLYFT_IMEX_EULER_INTEGRATOR_H_
+
+#include "flyft/brownian_diffusive_flux.h"
+#include "flyft/grand_potential.h"
+#include "flyft/integrator.h"
+#include "flyft/state.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace flyft
+    {
+
+//! Implicit-explicit Euler integrator for Brownian diffusion
+/*!
+ * The linear Fickian term of the Brownian flux is treated implicitly and the drift from the
+ * excess and external potentials is treated explicitly. The implicit part is a tridiagonal
+ * system, which is solved on each rank and then coupled across ranks through a reduced system
+ * for the first point on each rank. This removes the diffusive stability limit on the timestep.
+ */
+class IMEXEulerIntegrator : public Integrator
+    {
+    public:
+    IMEXEulerIntegrator(double timestep);
+
+    protected:
+    void step(std::shared_ptr<Flux> flux,
+              std::shared_ptr<GrandPotential> grand,
+              std::shared_ptr<State> state,
+              double timestep) override;
+
+    void stepInto(std::shared_ptr<Flux> flux,
+                  std::shared_ptr<GrandPotential> grand,
+                  std::shared_ptr<State> state,
+                  std::shared_ptr<State> next_state,
+                  double timestep) override;
+
+    int getLocalErrorExponent() const override
+        {
+        return 2;
+        }
+
+    private:
+    // tridiagonal system on the local mesh
+    std::vector<double> lower_;
+    std::vector<double> diag_;
+    std::vector<double> upper_;
+    std::vector<double> scratch_;
+
+    // partial solutions for each type
+    std::vector<double> rhs_;
+    std::vector<double> lower_response_;
+    std::vector<double> upper_response_;
+
+    void assemble(std::shared_ptr<BrownianDiffusiveFlux> flux,
+                  std::shared_ptr<GrandPotential> grand,
+                  std::shared_ptr<State> state,
+                  const std::string& type,
+                  double timestep,
+                  double* rhs);
+    void solveLocal(double* rhs, double* lower_response, double* upper_response, double* reduced);
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_IMEX_EULER_INTEGRATOR_H_
@@ -0,0 +1,90 @@
+#ifndef FLYFT_IMPLICIT_INTEGRATOR_H_
+#define FLYFT_IMPLICIT_INTEGRATOR_H_
+
+#include "flyft/field.h"
+#include "flyft/fixed_point_algorithm_mixin.h"
+#include "flyft/flux.h"
+#include "flyft/grand_potential.h"
+#include "flyft/integrator.h"
+#include "flyft/state.h"
+#include "flyft/type_map.h"
+
+#include <memory>
+#include <vector>
+
+namespace flyft
+    {
+
+//! Integrator that solves an implicit equation for the densities at the next step
+/*!
+ * The next densities solve rho = rho_0 + w R(rho), where rho_0 holds the explicit part of the step
+ * and R is the rate from the flux. The equation is solved by damped fixed-point iteration or by
+ * Jacobian-free Newton-Krylov, where each Newton step is solved by GMRES and the products with the
+ * Jacobian are finite differences of the flux.
+ */
+class ImplicitIntegrator : public Integrator, public FixedPointAlgorithmMixin
+    {
+    public:
+    enum class Method
+    {
+        fixed_point,
+        newton_krylov
+    };
+
+    ImplicitIntegrator(double timestep, double mix_param, int max_iterations, double tolerance);
+
+    bool advance(std::shared_ptr<Flux> flux,
+                 std::shared_ptr<GrandPotential> grand,
+                 std::shared_ptr<State> state,
+                 double time) override;
+
+    Method getMethod() const;
+    void setMethod(Method method);
+
+    int getKrylovDimension() const;
+    void setKrylovDimension(int dimension);
+
+    double getKrylovTolerance() const;
+    void setKrylovTolerance(double tolerance);
+
+    protected:
+    TypeMap<std::shared_ptr<Field>> explicit_fields_;
+
+    //! Solve for the densities of the state given the explicit part of the step
+    bool solve(std::shared_ptr<Flux> flux,
+               std::shared_ptr<GrandPotential> grand,
+               std::shared_ptr<State> state,
+               const TypeMap<std::shared_ptr<Field>>& explicit_fields,
+               double implicit_timestep);
+
+    private:
+    Method method_;
+    int krylov_dimension_;
+    double krylov_tolerance_;
+
+    std::shared_ptr<State> trial_state_;
+    TypeMap<std::shared_ptr<Field>> residual_;
+    TypeMap<std::shared_ptr<Field>> trial_residual_;
+    std::vector<TypeMap<std::shared_ptr<Field>>> krylov_basis_;
+
+    bool solveFixedPoint(std::shared_ptr<Flux> flux,
+                         std::shared_ptr<GrandPotential> grand,
+                         std::shared_ptr<State> state,
+                         const TypeMap<std::shared_ptr<Field>>& explicit_fields,
+                         double implicit_timestep);
+    bool solveNewtonKrylov(std::shared_ptr<Flux> flux,
+                           std::shared_ptr<GrandPotential> grand,
+                           std::shared_ptr<State> state,
+                           const TypeMap<std::shared_ptr<Field>>& explicit_fields,
+                           double implicit_timestep);
+    void computeResidual(std::shared_ptr<Flux> flux,
+                         std::shared_ptr<GrandPotential> grand,
+                         std::shared_ptr<State> state,
+                         const TypeMap<std::shared_ptr<Field>>& explicit_fields,
+                         double implicit_timestep,
+                         TypeMap<std::shared_ptr<Field>>& residual);
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_IMPLICIT_INTEGRATOR_H_
@@ -0,0 +1,72 @@
+#ifndef FLYFT_INDEXED_PAIR_MAP_H_
+#define FLYFT_INDEXED_PAIR_MAP_H_
+
+#include "flyft/pair_map.h"
+
+#include <string>
+#include <vector>
+
+namespace flyft
+    {
+
+//! Per-pair values stored densely by type index
+/*!
+ * The pairs are stored as a symmetric square matrix, so (i,j) and (j,i) refer to the same value.
+ * The index of a type is its position in the list of types used to build the map, which should be
+ * the order given by State::getTypes.
+ */
+template<typename T>
+class IndexedPairMap
+    {
+    public:
+    IndexedPairMap() : num_types_(0) {}
+
+    explicit IndexedPairMap(int num_types)
+        : num_types_(num_types), data_(num_types * num_types)
+        {
+        }
+
+    IndexedPairMap(const std::vector<std::string>& types, const PairMap<T>& map)
+        {
+        assign(types, map);
+        }
+
+    void assign(const std::vector<std::string>& types, const PairMap<T>& map)
+        {
+        num_types_ = static_cast<int>(types.size());
+        data_.resize(num_types_ * num_types_);
+        for (int i = 0; i < num_types_; ++i)
+            {
+            for (int j = i; j < num_types_; ++j)
+                {
+                const auto value = map(types[i], types[j]);
+                data_[i * num_types_ + j] = value;
+                data_[j * num_types_ + i] = value;
+                }
+            }
+        }
+
+    void set(int i, int j, const T& value)
+        {
+        data_[i * num_types_ + j] = value;
+        data_[j * num_types_ + i] = value;
+        }
+
+    const T& operator()(int i, int j) const
+        {
+        return data_[i * num_types_ + j];
+        }
+
+    int getNumTypes() const
+        {
+        return num_types_;
+        }
+
+    private:
+    int num_types_;
+    std::vector<T> data_;
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_INDEXED_PAIR_MAP_H_
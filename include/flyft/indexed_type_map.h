@@ -0,0 +1,91 @@
+#ifndef FLYFT_INDEXED_TYPE_MAP_H_
+#define FLYFT_INDEXED_TYPE_MAP_H_
+
+#include "flyft/type_map.h"
+
+#include <string>
+#include <vector>
+
+namespace flyft
+    {
+
+//! Per-type values stored densely by type index
+/*!
+ * The index of a type is its position in the list of types used to build the map, which should
+ * be the order given by State::getTypes. Lookups are an array load, so this map should be
+ * preferred over a TypeMap inside loops.
+ */
+template<typename T>
+class IndexedTypeMap
+    {
+    private:
+    using data_type = std::vector<T>;
+
+    public:
+    using value_type = typename data_type::value_type;
+    using size_type = typename data_type::size_type;
+    using reference = typename data_type::reference;
+    using const_reference = typename data_type::const_reference;
+    using iterator = typename data_type::iterator;
+    using const_iterator = typename data_type::const_iterator;
+
+    IndexedTypeMap() {}
+
+    explicit IndexedTypeMap(int num_types) : data_(num_types) {}
+
+    IndexedTypeMap(const std::vector<std::string>& types, const TypeMap<T>& map)
+        {
+        assign(types, map);
+        }
+
+    void assign(const std::vector<std::string>& types, const TypeMap<T>& map)
+        {
+        data_.resize(types.size());
+        for (size_type i = 0; i < data_.size(); ++i)
+            {
+            data_[i] = map(types[i]);
+            }
+        }
+
+    reference operator[](int i)
+        {
+        return data_[i];
+        }
+
+    const_reference operator()(int i) const
+        {
+        return data_[i];
+        }
+
+    iterator begin()
+        {
+        return data_.begin();
+        }
+
+    iterator end()
+        {
+        return data_.end();
+        }
+
+    const_iterator cbegin() const
+        {
+        return data_.cbegin();
+        }
+
+    const_iterator cend() const
+        {
+        return data_.cend();
+        }
+
+    int size() const
+        {
+        return static_cast<int>(data_.size());
+        }
+
+    private:
+    data_type data_;
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_INDEXED_TYPE_MAP_H_
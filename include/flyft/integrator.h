@@ -61,6 +61,17 @@ class Integrator
                       double timestep)
         = 0;
 
+    //! Step from one state into another, leaving the first state unchanged
+    /*!
+     * The default copies the state and steps in place, which is kept for integrators defined
+     * in python. The integrators in the library write the update directly into the other state.
+     */
+    virtual void stepInto(std::shared_ptr<Flux> flux,
+                          std::shared_ptr<GrandPotential> grand,
+                          std::shared_ptr<State> state,
+                          std::shared_ptr<State> next_state,
+                          double timestep);
+
     virtual int getLocalErrorExponent() const = 0;
     };
 
@@ -1,7 +1,9 @@
 #ifndef FLYFT_MESH_H_
 #define FLYFT_MESH_H_
+#include "flyft/aligned_allocator.h"
 #include "flyft/boundary_type.h"
 #include "flyft/data_view.h"
+#include "flyft/field.h"
 
 #include <exception>
 #include <memory>
@@ -21,14 +23,17 @@ class Mesh
 
     std::shared_ptr<Mesh> slice(int start, int end) const;
 
+    //! Make a mesh with the same bounds and boundary conditions but a different shape
+    std::shared_ptr<Mesh> coarsen(int shape) const;
+
     //! Get position on the mesh, defined as center of bin
-    double center(int i) const;
+    virtual double center(int i) const;
 
     //! Lower bound of entire mesh
     double lower_bound() const;
 
     //! Get lower bound of bin
-    double lower_bound(int i) const;
+    virtual double lower_bound(int i) const;
 
     //! Upper bound of entire mesh
     double upper_bound() const;
@@ -46,10 +51,22 @@ class Mesh
     virtual double volume(int i) const = 0;
 
     //! Get the bin for a coordinate
-    int bin(double x) const;
+    virtual int bin(double x) const;
+
+    //! Cached bin centers for 0 <= i < shape()
+    const double* centers() const;
+
+    //! Cached lower-edge surface areas for 0 <= i <= shape()
+    const double* areas() const;
+
+    //! Cached bin volumes for 0 <= i < shape()
+    const double* volumes() const;
+
+    //! Cached inverse bin volumes for 0 <= i < shape()
+    const double* inverse_volumes() const;
 
     //! Length of the mesh
-    double L() const;
+    virtual double L() const;
 
     //! Shape of the mesh
     int shape() const;
@@ -68,19 +85,19 @@ class Mesh
     double asLength(int shape) const;
 
     double integrateSurface(int idx, double j_lo, double j_hi) const;
-    double integrateSurface(int idx, const DataView<double>& j) const;
-    double integrateSurface(int idx, const DataView<const double>& j) const;
+    double integrateSurface(int idx, const DataView<FieldValue>& j) const;
+    double integrateSurface(int idx, const DataView<const FieldValue>& j) const;
 
     double integrateVolume(int idx, double f) const;
-    double integrateVolume(int idx, const DataView<double>& f) const;
-    double integrateVolume(int idx, const DataView<const double>& f) const;
+    double integrateVolume(int idx, const DataView<FieldValue>& f) const;
+    double integrateVolume(int idx, const DataView<const FieldValue>& f) const;
 
     template<typename T>
     typename std::remove_const<T>::type interpolate(double x, const DataView<T>& f) const;
 
     virtual double gradient(int idx, double f_lo, double f_hi) const = 0;
-    double gradient(int idx, const DataView<const double>& f) const;
-    double gradient(int idx, const DataView<double>& f) const;
+    double gradient(int idx, const DataView<const FieldValue>& f) const;
+    double gradient(int idx, const DataView<FieldValue>& f) const;
 
     bool operator==(const Mesh& other) const;
     bool operator!=(const Mesh& other) const;
@@ -94,8 +111,28 @@ class Mesh
     int start_;
 
     void validateBoundaryCondition() const;
+    void setupGeometry();
+
+    //! Change the number of bins while keeping the bounds
+    virtual void resample(int shape);
+
+    //! Check if the bins of another mesh of the same type are in the same places
+    virtual bool sameGeometry(const Mesh& other) const;
+
+    //! Check if the gradient on the lower edge of a bin is zeroed by a reflecting boundary
+    bool isReflectingEdge(int idx) const
+        {
+        return ((idx == 0 && lower_bc_ == BoundaryType::reflect)
+                || (idx == shape_ - 1 && upper_bc_ == BoundaryType::reflect));
+        }
 
     virtual std::shared_ptr<Mesh> clone() const = 0;
+
+    private:
+    AlignedVector<double> centers_;
+    AlignedVector<double> areas_;
+    AlignedVector<double> volumes_;
+    AlignedVector<double> inverse_volumes_;
     };
 
 template<typename T>
@@ -0,0 +1,37 @@
+#ifndef FLYFT_MESH_DISPATCH_H_
+#define FLYFT_MESH_DISPATCH_H_
+
+#include "flyft/cartesian_mesh.h"
+#include "flyft/mesh.h"
+#include "flyft/spherical_mesh.h"
+
+namespace flyft
+    {
+
+//! Call a function with a mesh cast to its concrete type
+/*!
+ * The function is called with a const CartesianMesh* or const SphericalMesh* when the mesh has
+ * one of these types, so a kernel written as a template (or generic lambda) on the mesh type is
+ * compiled with the geometry inlined. Any other mesh is passed as a const Mesh*, which uses the
+ * virtual geometry. The dispatch should be done once per compute call, outside any loops.
+ */
+template<class Function>
+void dispatchMesh(const Mesh* mesh, Function&& f)
+    {
+    if (auto cartesian = dynamic_cast<const CartesianMesh*>(mesh))
+        {
+        f(cartesian);
+        }
+    else if (auto spherical = dynamic_cast<const SphericalMesh*>(mesh))
+        {
+        f(spherical);
+        }
+    else
+        {
+        f(mesh);
+        }
+    }
+
+    } // namespace flyft
+
+#endif // FLYFT_MESH_DISPATCH_H_
@@ -0,0 +1,57 @@
+#ifndef FLYFT_MULTILEVEL_SOLVER_H_
+#define FLYFT_MULTILEVEL_SOLVER_H_
+
+#include "flyft/grand_potential.h"
+#include "flyft/parallel_mesh.h"
+#include "flyft/solver.h"
+#include "flyft/state.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace flyft
+    {
+
+//! Solve on a hierarchy of coarser meshes to seed the solve on the mesh of the state
+/*!
+ * Each coarser level halves the shape of the one above it, keeping the bounds and boundary
+ * conditions, until there are the requested number of levels or the next level would have fewer
+ * than the minimum shape. The densities of the state are averaged onto the coarsest level, which
+ * is solved first, and each solution is interpolated onto the next finer level as its initial
+ * guess. The coarse levels are solved redundantly on every rank, so only the finest level is
+ * distributed.
+ */
+class MultilevelSolver : public Solver
+    {
+    public:
+    MultilevelSolver(std::shared_ptr<Solver> solver, int num_levels, int min_shape);
+
+    bool solve(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override;
+
+    std::shared_ptr<Solver> getSolver();
+    void setSolver(std::shared_ptr<Solver> solver);
+
+    int getNumLevels() const;
+    void setNumLevels(int num_levels);
+
+    int getMinShape() const;
+    void setMinShape(int min_shape);
+
+    private:
+    std::shared_ptr<Solver> solver_;
+    int num_levels_;
+    int min_shape_;
+
+    std::shared_ptr<ParallelMesh> mesh_;         //!< Mesh the levels were made for
+    std::vector<std::string> types_;             //!< Types the levels were made for
+    std::vector<std::shared_ptr<State>> levels_; //!< Coarse levels, coarsest first
+
+    void setupLevels(std::shared_ptr<State> state);
+    static void restrictFields(std::shared_ptr<State> fine, std::shared_ptr<State> coarse);
+    static void prolongFields(std::shared_ptr<State> coarse, std::shared_ptr<State> fine);
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_MULTILEVEL_SOLVER_H_
@@ -0,0 +1,61 @@
+#ifndef FLYFT_NONUNIFORM_CARTESIAN_MESH_H_
+#define FLYFT_NONUNIFORM_CARTESIAN_MESH_H_
+
+#include "flyft/mesh.h"
+
+#include <vector>
+
+namespace flyft
+    {
+
+//! Cartesian mesh with bins of different widths
+/*!
+ * The bins are given by the positions of their edges, so the mesh can be refined near walls and
+ * interfaces. Outside the mesh, the bins mirror the widths of the bins at the boundary, or wrap
+ * around for periodic boundaries. The step of the mesh is the smallest bin width, which is used
+ * to convert lengths to numbers of bins. Functionals that need a uniform mesh, like those
+ * computing convolutions with Fourier transforms, do not support this mesh.
+ */
+class NonuniformCartesianMesh final : public Mesh
+    {
+    public:
+    NonuniformCartesianMesh(const std::vector<double>& edges,
+                            BoundaryType lower_bc,
+                            BoundaryType upper_bc,
+                            double area);
+
+    using Mesh::lower_bound;
+    double lower_bound(int i) const override;
+    double center(int i) const override;
+    int bin(double x) const override;
+    double L() const override;
+
+    double area(int i) const override;
+    double volume() const override;
+    double volume(int i) const override;
+
+    using Mesh::gradient;
+    double gradient(int idx, double f_lo, double f_hi) const override;
+
+    //! Edges of the bins of the entire mesh
+    const std::vector<double>& edges() const;
+
+    protected:
+    std::shared_ptr<Mesh> clone() const override;
+    void resample(int shape) override;
+    bool sameGeometry(const Mesh& other) const override;
+
+    private:
+    std::vector<double> edges_; //!< Edges of the bins of the entire mesh
+    double area_;               //<! Cross sectional area
+    bool periodic_;             //!< Whether the entire mesh is periodic
+
+    void setupStep();
+
+    //! Position of an edge by its index in the entire mesh, which may be outside the mesh
+    double edge(int idx) const;
+    };
+
+    } // namespace flyft
+
+#endif // FLYFT_NONUNIFORM_CARTESIAN_MESH_H_
@@ -6,6 +6,7 @@
 #include "flyft/mesh.h"
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -48,6 +49,7 @@ class ParallelMesh
     std::vector<int> ends_;
 
     std::unordered_map<Field::Identifier, Field::Token> field_tokens_;
+    std::mutex field_tokens_mutex_; //!< Guards the tokens for states solved on different threads
 #ifdef FLYFT_MPI
     std::unordered_map<Field::Identifier, std::vector<MPI_Request>> field_requests_;
 #endif // FLYFT_MPI
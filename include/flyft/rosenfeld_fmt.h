@@ -25,12 +25,25 @@ class RosenfeldFMT : public Functional
     TypeMap<double>& getDiameters();
     const TypeMap<double>& getDiameters() const;
 
+    //! Share storage between scratch fields that are not needed at the same time
+    /*!
+     * The reciprocal-space weighted densities are reused for the transformed derivatives of phi,
+     * and the per-type temporaries reuse fields that are idle in the phase of the calculation
+     * where they are needed. The results are the same, but the scratch fields cannot be
+     * inspected after the calculation.
+     */
+    bool getLowMemory() const;
+    void setLowMemory(bool low_memory);
+
     int determineBufferShape(std::shared_ptr<State> state, const std::string& type) override;
 
     protected:
     TypeMap<double> diameters_;
     std::unique_ptr<FourierTransform> ft_;
+    std::unique_ptr<FourierTransform> ft_vector_; //!< Transform for vector weighted densities
+    int shape_;
     int buffer_shape_;
+    bool low_memory_;
 
     std::shared_ptr<Field> n0_;
     std::shared_ptr<Field> n1_;
@@ -47,26 +60,31 @@ class RosenfeldFMT : public Functional
     std::shared_ptr<Field> dphi_dnv1_;
     std::shared_ptr<Field> dphi_dnv2_;
 
-    std::unique_ptr<ComplexField> dphi_dn0k_;
-    std::unique_ptr<ComplexField> dphi_dn1k_;
-    std::unique_ptr<ComplexField> dphi_dn2k_;
-    std::unique_ptr<ComplexField> dphi_dn3k_;
-    std::unique_ptr<ComplexField> dphi_dnv1k_;
-    std::unique_ptr<ComplexField> dphi_dnv2k_;
+    std::shared_ptr<ComplexField> dphi_dn0k_;
+    std::shared_ptr<ComplexField> dphi_dn1k_;
+    std::shared_ptr<ComplexField> dphi_dn2k_;
+    std::shared_ptr<ComplexField> dphi_dn3k_;
+    std::shared_ptr<ComplexField> dphi_dnv1k_;
+    std::shared_ptr<ComplexField> dphi_dnv2k_;
 
-    std::unique_ptr<ComplexField> derivativek_;
+    std::shared_ptr<ComplexField> derivativek_;
 
     bool setup(std::shared_ptr<State> state, bool compute_value) override;
     void _compute(std::shared_ptr<State> state, bool compute_value) override;
 
     void computeCartesianWeightedDensities(std::shared_ptr<State> state);
+    void computeCartesianCosineWeightedDensities(std::shared_ptr<State> state);
     void computeSphericalWeightedDensities(std::shared_ptr<State> state);
+    void computeSphericalSineWeightedDensities(std::shared_ptr<State> state);
 
     std::map<std::string, std::shared_ptr<Field>> tmp_field_;
-    std::map<std::string, std::unique_ptr<ComplexField>> tmp_complex_field_;
+    std::map<std::string, std::shared_ptr<ComplexField>> tmp_complex_field_;
+    std::map<std::string, std::shared_ptr<Field>> tmp_coefficient_field_;
 
     void computeCartesianDerivative(std::shared_ptr<State> state);
+    void computeCartesianCosineDerivative(std::shared_ptr<State> state);
     void computeSphericalDerivative(std::shared_ptr<State> state);
+    void computeSphericalSineDerivative(std::shared_ptr<State> state);
 
     virtual void computePrefactorFunctions(double& f1,
                                            double& f2,
@@ -104,17 +122,57 @@ class RosenfeldFMT : public Functional
                                      const double R) const;
 
     void setupField(std::shared_ptr<Field>& field);
-    void setupComplexField(std::unique_ptr<ComplexField>& kfield);
-
+    void setupComplexField(std::shared_ptr<ComplexField>& kfield);
+    void setupCoefficientField(std::shared_ptr<Field>& kfield);
+
+    //! How the weighted densities are convolved
+    /*!
+     * Cartesian meshes reflecting at both ends are expanded in cosine series, and spherical
+     * meshes that include the origin are expanded in sine series of r times the fields. Other
+     * meshes are padded with their buffers and transformed as periodic data.
+     */
     enum struct ConvolutionType
     {
         cartesian,
-        spherical
+        cartesian_cosine,
+        spherical,
+        spherical_sine
     };
     ConvolutionType getConvolutionType(std::shared_ptr<const Mesh> mesh) const;
 
+    //! Quadrature of the weighted densities for the spherical bins within R of the origin
+    /*!
+     * The trapezoidal rule and the linear interpolation between bins are both linear in the
+     * integrated field, so they collapse into dense matrices that only depend on the mesh and
+     * the radius. The scalar matrices also convolve the derivatives of phi, but the vector
+     * weight is not symmetric in its two points, so its derivative has its own matrix.
+     */
+    struct OriginQuadrature
+        {
+        double R;                 //!< Radius of the weights
+        double lower_bound;       //!< Lower bound of the mesh
+        double step;              //!< Step of the mesh
+        int shape;                //!< Shape of the mesh
+        int rows;                 //!< Number of bins within R of the origin
+        int first_column;         //!< First bin read by the quadrature
+        int columns;              //!< Number of bins read by the quadrature
+        std::vector<double> w2;   //!< Row-major matrix for n2
+        std::vector<double> w3;   //!< Row-major matrix for n3
+        std::vector<double> wv2;  //!< Row-major matrix for nv2
+        std::vector<double> dwv2; //!< Row-major matrix for the derivative with respect to nv2
+        };
+    std::map<std::string, OriginQuadrature> origin_quadrature_;
+    const OriginQuadrature&
+    getOriginQuadrature(const std::string& type, const Mesh* mesh, double R);
+
     std::shared_ptr<Field> tmp_r_field_;
-    void fourierTransformFieldSpherical(const Field::ConstantView& input, const Mesh* mesh) const;
+    void fourierTransformFieldSpherical(const Field::ConstantView& input,
+                                        const Mesh* mesh,
+                                        bool multiply_r) const;
+    void fourierTransformFieldRadial(FourierTransform& ft,
+                                     const Field::ConstantView& input,
+                                     const Mesh* mesh,
+                                     bool multiply_r);
     };
 
 template<typename T>
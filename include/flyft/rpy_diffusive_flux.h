@@ -23,7 +23,7 @@ class RPYDiffusiveFlux : public Flux
     void setViscosity(double viscosity);
 
     protected:
-    void compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override;
+    void _compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override;
     int determineBufferShape(std::shared_ptr<State> state, const std::string& type) override;
 
     private:
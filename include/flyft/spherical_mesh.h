@@ -1,13 +1,15 @@
 #ifndef FLYFT_SPHERICAL_MESH_H_
+#define FLYFT_SPHERICAL_MESH_H_
 
 #include "flyft/mesh.h"
 
+#include <cmath>
 #include <exception>
 
 namespace flyft
     {
 
-class SphericalMesh : public Mesh
+class SphericalMesh final : public Mesh
     {
     public:
     SphericalMesh(double lower_bound,
@@ -21,10 +23,51 @@ class SphericalMesh : public Mesh
     double volume(int i) const override;
     double gradient(int idx, double f_lo, double f_hi) const override;
 
+    // nonvirtual versions of the Mesh methods that can be inlined for this geometry
+    double gradient(int idx, const DataView<const FieldValue>& f) const;
+    double gradient(int idx, const DataView<FieldValue>& f) const;
+
     protected:
     void validateBoundaryCondition() const;
     std::shared_ptr<Mesh> clone() const override;
     };
+
+// geometry is defined inline so that kernels templated on the mesh type can inline it
+inline double SphericalMesh::area(int i) const
+    {
+    const double r = lower_bound(i);
+    return 4. * M_PI * r * r;
+    }
+
+inline double SphericalMesh::volume() const
+    {
+    const double rlo = lower_bound();
+    const double rhi = upper_bound();
+    return (4. * M_PI / 3.) * (rhi * rhi * rhi - rlo * rlo * rlo);
+    }
+
+inline double SphericalMesh::volume(int i) const
+    {
+    const double r_out = upper_bound(i);
+    const double r_in = lower_bound(i);
+    return (4. * M_PI / 3.) * (r_out * r_out * r_out - r_in * r_in * r_in);
+    }
+
+inline double SphericalMesh::gradient(int /*i*/, double f_lo, double f_hi) const
+    {
+    return (f_hi - f_lo) / (step_);
+    }
+
+inline double SphericalMesh::gradient(int idx, const DataView<const FieldValue>& f) const
+    {
+    return (isReflectingEdge(idx)) ? 0. : gradient(idx, f(idx - 1), f(idx));
+    }
+
+inline double SphericalMesh::gradient(int idx, const DataView<FieldValue>& f) const
+    {
+    return (isReflectingEdge(idx)) ? 0. : gradient(idx, f(idx - 1), f(idx));
+    }
+
     } // namespace flyft
 
 #endif // FLYFT_SPHERICAL_MESH_H_
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace flyft
@@ -26,6 +27,13 @@ class State : public TrackedObject
     State& operator=(const State& other);
     State& operator=(State&& other);
 
+    //! Exchange fields and time with another state on the same mesh without copying
+    /*!
+     * The data inside the fields is exchanged, so fields previously obtained from either state
+     * still belong to it and see its new values.
+     */
+    void swap(State& other);
+
     std::shared_ptr<ParallelMesh> getMesh();
     std::shared_ptr<const ParallelMesh> getMesh() const;
     std::shared_ptr<Communicator> getCommunicator();
@@ -65,6 +73,7 @@ class State : public TrackedObject
     private:
     std::shared_ptr<ParallelMesh> mesh_;
     std::vector<std::string> types_;
+    std::unordered_map<std::string, int> type_indexes_;
     TypeMap<std::shared_ptr<Field>> fields_;
     double time_;
 
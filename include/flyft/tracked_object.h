@@ -1,6 +1,7 @@
 #ifndef FLYFT_TRACKED_OBJECT_H_
 #define FLYFT_TRACKED_OBJECT_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
@@ -77,7 +78,7 @@ class TrackedObject
     protected:
     Identifier id_;
     Token token_;
-    static Identifier count;
+    static std::atomic<Identifier> count;
     };
 
     } // namespace flyft
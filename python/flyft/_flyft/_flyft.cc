@@ -10,9 +10,11 @@ void bindDoubleParameters(py::module_&);
 void bindBoundaryType(py::module_&);
 void bindCommunicator(py::module_&);
 void bindField(py::module_&);
+void bindFourierTransform(py::module_&);
 void bindMesh(py::module_&);
 void bindSphericalMesh(py::module_&);
 void bindCartesianMesh(py::module_&);
+void bindNonuniformCartesianMesh(py::module_&);
 void bindParallelMesh(py::module_&);
 void bindState(py::module_&);
 
@@ -36,6 +38,9 @@ void bindLennardJones93WallPotential(py::module_&);
 
 void bindSolver(py::module_&);
 void bindPicardIteration(py::module_&);
+void bindEnsemble(py::module_&);
+void bindContinuation(py::module_&);
+void bindMultilevelSolver(py::module_&);
 
 void bindFlux(py::module_&);
 void bindCompositeFlux(py::module_&);
@@ -43,8 +48,12 @@ void bindBrownianDiffusiveFlux(py::module_&);
 void bindRPYDiffusiveFlux(py::module_&);
 
 void bindIntegrator(py::module_&);
+void bindImplicitIntegrator(py::module_&);
+void bindBogackiShampineIntegrator(py::module_&);
 void bindCrankNicolsonIntegrator(py::module_&);
+void bindDormandPrinceIntegrator(py::module_&);
 void bindExplicitEulerIntegrator(py::module_&);
+void bindIMEXEulerIntegrator(py::module_&);
 void bindImplicitEulerIntegrator(py::module_&);
 
 #ifdef FLYFT_MPI
@@ -72,8 +81,10 @@ PYBIND11_MODULE(_flyft, m)
     bindBoundaryType(m);
     bindCommunicator(m);
     bindField(m);
+    bindFourierTransform(m);
     bindMesh(m);
     bindCartesianMesh(m);
+    bindNonuniformCartesianMesh(m);
     bindSphericalMesh(m);
     bindParallelMesh(m);
     bindState(m);
@@ -98,6 +109,9 @@ PYBIND11_MODULE(_flyft, m)
 
     bindSolver(m);
     bindPicardIteration(m);
+    bindEnsemble(m);
+    bindContinuation(m);
+    bindMultilevelSolver(m);
 
     bindFlux(m);
     bindCompositeFlux(m);
@@ -105,7 +119,11 @@ PYBIND11_MODULE(_flyft, m)
     bindRPYDiffusiveFlux(m);
 
     bindIntegrator(m);
+    bindImplicitIntegrator(m);
+    bindBogackiShampineIntegrator(m);
     bindCrankNicolsonIntegrator(m);
+    bindDormandPrinceIntegrator(m);
     bindExplicitEulerIntegrator(m);
+    bindIMEXEulerIntegrator(m);
     bindImplicitEulerIntegrator(m);
     }
@@ -0,0 +1,13 @@
+#include "flyft/bogacki_shampine_integrator.h"
+
+#include "_flyft.h"
+
+void bindBogackiShampineIntegrator(py::module_& m)
+    {
+    using namespace flyft;
+
+    py::class_<BogackiShampineIntegrator, std::shared_ptr<BogackiShampineIntegrator>, Integrator>(
+        m,
+        "BogackiShampineIntegrator")
+        .def(py::init<double>());
+    }
@@ -7,5 +7,6 @@ void bindCartesianMesh(py::module_& m)
     using namespace flyft;
 
     py::class_<CartesianMesh, std::shared_ptr<CartesianMesh>, Mesh>(m, "CartesianMesh")
-        .def(py::init<double, double, int, BoundaryType, BoundaryType, double>());
+        .def(py::init<double, double, int, BoundaryType, BoundaryType, double>())
+        .def_static("fast_shape", &CartesianMesh::fastShape);
     }
@@ -0,0 +1,24 @@
+#include "flyft/continuation.h"
+
+#include "_flyft.h"
+
+void bindContinuation(py::module_& m)
+    {
+    using namespace flyft;
+
+    py::class_<Continuation, std::shared_ptr<Continuation>> continuation(m, "Continuation");
+    continuation.def(py::init<std::shared_ptr<Solver>, Continuation::Predictor>())
+        .def("solve", &Continuation::solve)
+        .def("reset", &Continuation::reset)
+        .def_property("solver", &Continuation::getSolver, &Continuation::setSolver)
+        .def_property("predictor", &Continuation::getPredictor, &Continuation::setPredictor)
+        .def_property("control_type",
+                      &Continuation::getControlType,
+                      &Continuation::setControlType)
+        .def_property_readonly("num_solutions", &Continuation::getNumSolutions);
+
+    py::enum_<Continuation::Predictor>(continuation, "Predictor")
+        .value("none", Continuation::Predictor::none)
+        .value("secant", Continuation::Predictor::secant)
+        .value("quadratic", Continuation::Predictor::quadratic);
+    }
@@ -0,0 +1,13 @@
+#include "flyft/dormand_prince_integrator.h"
+
+#include "_flyft.h"
+
+void bindDormandPrinceIntegrator(py::module_& m)
+    {
+    using namespace flyft;
+
+    py::class_<DormandPrinceIntegrator, std::shared_ptr<DormandPrinceIntegrator>, Integrator>(
+        m,
+        "DormandPrinceIntegrator")
+        .def(py::init<double>());
+    }
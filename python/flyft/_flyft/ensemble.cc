@@ -0,0 +1,21 @@
+#include "flyft/ensemble.h"
+
+#include "_flyft.h"
+
+#include <pybind11/stl.h>
+
+void bindEnsemble(py::module_& m)
+    {
+    using namespace flyft;
+
+    py::class_<Ensemble, std::shared_ptr<Ensemble>>(m, "Ensemble")
+        .def(py::init())
+        .def("__len__", &Ensemble::size)
+        .def("append", &Ensemble::addSystem)
+        .def("remove", &Ensemble::removeSystem)
+        .def("clear", &Ensemble::clearSystems)
+        .def("grand_potential", &Ensemble::getGrandPotential)
+        .def("state", &Ensemble::getState)
+        .def_property_readonly("concurrent", &Ensemble::canSolveConcurrently)
+        .def("solve", &Ensemble::solve, py::call_guard<py::gil_scoped_release>());
+    }
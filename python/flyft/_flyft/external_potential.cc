@@ -2,6 +2,8 @@
 
 #include "_flyft.h"
 
+#include <algorithm>
+
 namespace flyft
     {
 //! Trampoline for ExternalPotential to python
@@ -28,5 +30,17 @@ void bindExternalPotential(py::module_& m)
                std::shared_ptr<ExternalPotential>,
                ExternalPotentialTrampoline,
                Functional>(m, "ExternalPotential")
-        .def(py::init<>());
+        .def(py::init<>())
+        .def("active_range", &ExternalPotential::getActiveRange)
+        .def("boltzmann_factor",
+             [](const ExternalPotential& self, const std::string& type)
+             {
+                 // copy the cached factor so changes made in python cannot corrupt it
+                 auto factor = self.getBoltzmannFactor(type);
+                 auto copy = std::make_shared<Field>(factor->shape(), factor->buffer_shape());
+                 std::copy(factor->const_full_view().begin(),
+                           factor->const_full_view().end(),
+                           copy->full_view().begin());
+                 return copy;
+             });
     }
@@ -19,7 +19,7 @@ void bindField(py::module_& m)
                  return f(idx);
              })
         .def("__setitem__",
-             [](Field& f, int idx, double value)
+             [](Field& f, int idx, FieldValue value)
              {
                  if (idx < 0 || idx >= f.shape())
                      throw py::index_error();
@@ -29,10 +29,10 @@ void bindField(py::module_& m)
             [](Field& f) -> py::buffer_info
             {
                 return py::buffer_info(&f(0),
-                                       sizeof(double),
-                                       py::format_descriptor<double>::format(),
+                                       sizeof(FieldValue),
+                                       py::format_descriptor<FieldValue>::format(),
                                        1,
                                        {f.shape()},
-                                       {sizeof(double)});
+                                       {sizeof(FieldValue)});
             });
     }
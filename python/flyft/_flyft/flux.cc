@@ -13,10 +13,36 @@ class FluxTrampoline : public Flux
     // Pull in constructors
     using Flux::Flux;
 
+    //! Call a python override of compute, which subclasses overrode before _compute
+    /*!
+     * The override is called on every evaluation, so the flux is always treated as changed.
+     * Subclasses without one go through the cached compute of the base class.
+     */
+    Token compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override
+        {
+        py::gil_scoped_acquire gil;
+        py::function override = py::get_override(static_cast<const Flux*>(this), "compute");
+        if (override)
+            {
+            if (PyErr_WarnEx(PyExc_DeprecationWarning,
+                             "Overriding Flux.compute is deprecated, override _compute instead",
+                             1)
+                < 0)
+                {
+                throw py::error_already_set();
+                }
+            override(grand, state);
+            token_.stageAndCommit();
+            return token_;
+            }
+        return Flux::compute(grand, state);
+        }
+
+    protected:
     //! pybind11 override of pure virtual compute method
-    void compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override
+    void _compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state) override
         {
-        PYBIND11_OVERRIDE_PURE(void, Flux, compute, grand, state);
+        PYBIND11_OVERRIDE_PURE(void, Flux, _compute, grand, state);
         }
     };
     } // namespace flyft
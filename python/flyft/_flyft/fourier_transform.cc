@@ -0,0 +1,72 @@
+#include "flyft/fourier_transform.h"
+
+#include "_flyft.h"
+
+#include <pybind11/stl.h>
+
+#include <stdexcept>
+
+void bindFourierTransform(py::module_& m)
+    {
+    using namespace flyft;
+
+    py::class_<FourierTransform, std::shared_ptr<FourierTransform>> ft(m, "FourierTransform");
+
+    py::enum_<FourierTransform::Symmetry>(ft, "Symmetry")
+        .value("periodic", FourierTransform::Symmetry::periodic)
+        .value("even", FourierTransform::Symmetry::even)
+        .value("odd", FourierTransform::Symmetry::odd)
+        .value("odd_even", FourierTransform::Symmetry::odd_even)
+        .value("even_odd", FourierTransform::Symmetry::even_odd);
+
+    ft.def(py::init<double, int, FourierTransform::Symmetry, bool>())
+        .def("transform", &FourierTransform::transform)
+        .def_property_readonly("L", &FourierTransform::getL)
+        .def_property_readonly("N", &FourierTransform::getN)
+        .def_property_readonly("padded_N", &FourierTransform::getPaddedN)
+        .def_property_readonly("symmetry", &FourierTransform::getSymmetry)
+        .def_property_readonly("wavevectors",
+                               [](const FourierTransform& self)
+                               {
+                                   const auto& kmesh = self.getWavevectors();
+                                   std::vector<double> k(kmesh.shape());
+                                   for (int idx = 0; idx < kmesh.shape(); ++idx)
+                                       {
+                                       k[idx] = kmesh(idx);
+                                       }
+                                   return k;
+                               })
+        .def_property(
+            "real",
+            [](const FourierTransform& self)
+            {
+                auto data = self.const_view_real();
+                return std::vector<FieldValue>(data.begin(), data.end());
+            },
+            [](FourierTransform& self, const std::vector<FieldValue>& data)
+            {
+                if (static_cast<int>(data.size()) != self.getN())
+                    {
+                    throw std::invalid_argument("Real data must have the shape of the transform");
+                    }
+                self.setRealData(FourierTransform::ConstantRealView(data.data(),
+                                                                    DataLayout(data.size())));
+            })
+        .def_property(
+            "coefficients",
+            [](const FourierTransform& self)
+            {
+                auto data = self.const_view_coefficients();
+                return std::vector<FieldValue>(data.begin(), data.end());
+            },
+            [](FourierTransform& self, const std::vector<FieldValue>& data)
+            {
+                if (static_cast<int>(data.size()) != self.getWavevectors().shape())
+                    {
+                    throw std::invalid_argument(
+                        "Coefficients must have the shape of the wavevectors");
+                    }
+                self.setCoefficients(FourierTransform::ConstantRealView(data.data(),
+                                                                        DataLayout(data.size())));
+            });
+    }
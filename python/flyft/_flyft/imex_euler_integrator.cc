@@ -0,0 +1,13 @@
+#include "flyft/imex_euler_integrator.h"
+
+#include "_flyft.h"
+
+void bindIMEXEulerIntegrator(py::module_& m)
+    {
+    using namespace flyft;
+
+    py::class_<IMEXEulerIntegrator, std::shared_ptr<IMEXEulerIntegrator>, Integrator>(
+        m,
+        "IMEXEulerIntegrator")
+        .def(py::init<double>());
+    }
@@ -0,0 +1,33 @@
+#include "flyft/implicit_integrator.h"
+
+#include "_flyft.h"
+
+void bindImplicitIntegrator(py::module_& m)
+    {
+    using namespace flyft;
+
+    py::class_<ImplicitIntegrator, std::shared_ptr<ImplicitIntegrator>, Integrator> integrator(
+        m,
+        "ImplicitIntegrator");
+    integrator
+        .def_property("method", &ImplicitIntegrator::getMethod, &ImplicitIntegrator::setMethod)
+        .def_property("mix_parameter",
+                      &ImplicitIntegrator::getMixParameter,
+                      &ImplicitIntegrator::setMixParameter)
+        .def_property("max_iterations",
+                      &ImplicitIntegrator::getMaxIterations,
+                      &ImplicitIntegrator::setMaxIterations)
+        .def_property("tolerance",
+                      &ImplicitIntegrator::getTolerance,
+                      &ImplicitIntegrator::setTolerance)
+        .def_property("krylov_dimension",
+                      &ImplicitIntegrator::getKrylovDimension,
+                      &ImplicitIntegrator::setKrylovDimension)
+        .def_property("krylov_tolerance",
+                      &ImplicitIntegrator::getKrylovTolerance,
+                      &ImplicitIntegrator::setKrylovTolerance);
+
+    py::enum_<ImplicitIntegrator::Method>(integrator, "Method")
+        .value("fixed_point", ImplicitIntegrator::Method::fixed_point)
+        .value("newton_krylov", ImplicitIntegrator::Method::newton_krylov);
+    }
@@ -0,0 +1,16 @@
+#include "flyft/multilevel_solver.h"
+
+#include "_flyft.h"
+
+void bindMultilevelSolver(py::module_& m)
+    {
+    using namespace flyft;
+
+    py::class_<MultilevelSolver, std::shared_ptr<MultilevelSolver>, Solver>(m, "MultilevelSolver")
+        .def(py::init<std::shared_ptr<Solver>, int, int>())
+        .def_property("solver", &MultilevelSolver::getSolver, &MultilevelSolver::setSolver)
+        .def_property("num_levels",
+                      &MultilevelSolver::getNumLevels,
+                      &MultilevelSolver::setNumLevels)
+        .def_property("min_shape", &MultilevelSolver::getMinShape, &MultilevelSolver::setMinShape);
+    }
@@ -0,0 +1,16 @@
+#include "flyft/nonuniform_cartesian_mesh.h"
+
+#include "_flyft.h"
+
+#include <pybind11/stl.h>
+
+void bindNonuniformCartesianMesh(py::module_& m)
+    {
+    using namespace flyft;
+
+    py::class_<NonuniformCartesianMesh, std::shared_ptr<NonuniformCartesianMesh>, Mesh>(
+        m,
+        "NonuniformCartesianMesh")
+        .def(py::init<const std::vector<double>&, BoundaryType, BoundaryType, double>())
+        .def_property_readonly("edges", &NonuniformCartesianMesh::edges);
+    }
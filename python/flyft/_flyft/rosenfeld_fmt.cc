@@ -11,5 +11,6 @@ void bindRosenfeldFMT(py::module_& m)
         .def(py::init())
         .def_property_readonly("diameters",
                                py::overload_cast<>(&RosenfeldFMT::getDiameters),
-                               py::return_value_policy::reference_internal);
+                               py::return_value_policy::reference_internal)
+        .def_property("low_memory", &RosenfeldFMT::getLowMemory, &RosenfeldFMT::setLowMemory);
     }
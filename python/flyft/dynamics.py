@@ -39,20 +39,47 @@ class Integrator(mirror.Mirror, mirrorclass=_flyft.Integrator):
         self.adapt_minimum = minimum
 
 
+class ImplicitIntegrator(
+    Integrator, FixedPointAlgorithmMixin, mirrorclass=_flyft.ImplicitIntegrator
+):
+    Method = _flyft.ImplicitIntegrator.Method
+
+    method = mirror.Property()
+    krylov_dimension = mirror.Property()
+    krylov_tolerance = mirror.Property()
+
+
 class CrankNicolsonIntegrator(
-    Integrator, FixedPointAlgorithmMixin, mirrorclass=_flyft.CrankNicolsonIntegrator
+    ImplicitIntegrator, mirrorclass=_flyft.CrankNicolsonIntegrator
 ):
     def __init__(self, timestep, mix_parameter, max_iterations, tolerance):
         super().__init__(timestep, mix_parameter, max_iterations, tolerance)
 
 
+class BogackiShampineIntegrator(
+    Integrator, mirrorclass=_flyft.BogackiShampineIntegrator
+):
+    def __init__(self, timestep):
+        super().__init__(timestep)
+
+
+class DormandPrinceIntegrator(Integrator, mirrorclass=_flyft.DormandPrinceIntegrator):
+    def __init__(self, timestep):
+        super().__init__(timestep)
+
+
 class ExplicitEulerIntegrator(Integrator, mirrorclass=_flyft.ExplicitEulerIntegrator):
     def __init__(self, timestep):
         super().__init__(timestep)
 
 
+class IMEXEulerIntegrator(Integrator, mirrorclass=_flyft.IMEXEulerIntegrator):
+    def __init__(self, timestep):
+        super().__init__(timestep)
+
+
 class ImplicitEulerIntegrator(
-    Integrator, FixedPointAlgorithmMixin, mirrorclass=_flyft.ImplicitEulerIntegrator
+    ImplicitIntegrator, mirrorclass=_flyft.ImplicitEulerIntegrator
 ):
     def __init__(self, timestep, mix_parameter, max_iterations, tolerance):
         super().__init__(timestep, mix_parameter, max_iterations, tolerance)
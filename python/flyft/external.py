@@ -1,10 +1,14 @@
 from . import _flyft, mirror
 from .functional import Functional
 from .mixins import CompositeMixin
+from .state import Field
 
 
 class ExternalPotential(Functional, mirrorclass=_flyft.ExternalPotential):
-    pass
+    active_range = mirror.Method()
+
+    def boltzmann_factor(self, type_):
+        return Field.wrap(self._self.boltzmann_factor(type_))
 
 
 class CompositeExternalPotential(
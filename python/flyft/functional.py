@@ -55,6 +55,7 @@ class IdealGas(Functional, mirrorclass=_flyft.IdealGasFunctional):
 
 class RosenfeldFMT(Functional, mirrorclass=_flyft.RosenfeldFMT):
     diameters = mirror.WrappedProperty(mirror.MutableMapping)
+    low_memory = mirror.Property()
 
 
 class VirialExpansion(Functional, mirrorclass=_flyft.VirialExpansion):
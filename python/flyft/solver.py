@@ -12,3 +12,63 @@ class PicardIteration(Solver, mirrorclass=_flyft.PicardIteration):
     mix_parameter = mirror.Property()
     max_iterations = mirror.Property()
     tolerance = mirror.Property()
+
+
+class MultilevelSolver(Solver, mirrorclass=_flyft.MultilevelSolver):
+    def __init__(self, solver, num_levels, min_shape=16):
+        super().__init__(solver, num_levels, min_shape)
+        self._solver = solver
+
+    solver = mirror.Property()
+    num_levels = mirror.Property()
+    min_shape = mirror.Property()
+
+
+class Ensemble(mirror.Mirror, mirrorclass=_flyft.Ensemble):
+    def __init__(self, systems=None):
+        super().__init__()
+        self._systems = []
+        if systems is not None:
+            for grand, state in systems:
+                self.append(grand, state)
+
+    def __getitem__(self, key):
+        return self._systems[key]
+
+    def __delitem__(self, key):
+        if key < 0:
+            key += len(self)
+        self._self.remove(key)
+        del self._systems[key]
+
+    def __iter__(self):
+        return iter(self._systems)
+
+    def __len__(self):
+        return len(self._systems)
+
+    def append(self, grand, state):
+        self._self.append(grand._self, state._self)
+        self._systems.append((grand, state))
+
+    def clear(self):
+        self._self.clear()
+        self._systems = []
+
+    solve = mirror.Method()
+    concurrent = mirror.Property()
+
+
+class Continuation(mirror.Mirror, mirrorclass=_flyft.Continuation):
+    Predictor = _flyft.Continuation.Predictor
+
+    def __init__(self, solver, predictor=Predictor.secant):
+        super().__init__(solver, predictor)
+        self._solver = solver
+
+    solve = mirror.Method()
+    reset = mirror.Method()
+    solver = mirror.Property()
+    predictor = mirror.Property()
+    control_type = mirror.Property()
+    num_solutions = mirror.Property()
@@ -117,11 +117,29 @@ class CartesianMesh(Mesh, mirrorclass=_flyft.CartesianMesh):
             upper_bc = Mesh._parse_boundary_condition(boundary_condition[1])
         super().__init__(0, L, shape, lower_bc, upper_bc, area)
 
+    @staticmethod
+    def fast_shape(shape):
+        return _flyft.CartesianMesh.fast_shape(shape)
+
+
+class NonuniformCartesianMesh(Mesh, mirrorclass=_flyft.NonuniformCartesianMesh):
+    def __init__(self, edges, boundary_condition, area=1.0):
+        if isinstance(boundary_condition, str):
+            lower_bc = upper_bc = Mesh._parse_boundary_condition(boundary_condition)
+        elif len(boundary_condition) == 2:
+            lower_bc = Mesh._parse_boundary_condition(boundary_condition[0])
+            upper_bc = Mesh._parse_boundary_condition(boundary_condition[1])
+        super().__init__(list(edges), lower_bc, upper_bc, area)
+
+    @property
+    def edges(self):
+        return np.array(self._self.edges)
+
 
 class SphericalMesh(Mesh, mirrorclass=_flyft.SphericalMesh):
-    def __init__(self, R, shape, boundary_condition):
+    def __init__(self, R, shape, boundary_condition, lower_bound=0.0):
         upper_bc = Mesh._parse_boundary_condition(boundary_condition)
-        super().__init__(0, R, shape, _flyft.BoundaryType.reflect, upper_bc)
+        super().__init__(lower_bound, R, shape, _flyft.BoundaryType.reflect, upper_bc)
 
 
 class ParallelMesh(mirror.Mirror, mirrorclass=_flyft.ParallelMesh):
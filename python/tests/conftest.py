@@ -1,3 +1,4 @@
+import numpy as np
 import pytest
 from pytest_lazy_fixtures import lf as lazy_fixture
 
@@ -76,6 +77,22 @@ def walls():
     return (flyft.external.HardWall(1.0, 1.0), flyft.external.HardWall(9.0, -1.0))
 
 
+@pytest.fixture
+def ideal_walls(grand, walls):
+    grand.ideal = flyft.functional.IdealGas()
+    grand.ideal.volumes["A"] = 1.0
+    for w in walls:
+        w.diameters["A"] = 0.0
+    grand.external = flyft.external.CompositeExternalPotential(walls)
+    return grand
+
+
+@pytest.fixture
+def inside_walls(state):
+    x = state.mesh.local.centers
+    return np.logical_and(x > 1.0, x <= 9.0)
+
+
 @pytest.fixture
 def bd():
     return flyft.dynamics.BrownianDiffusiveFlux()
@@ -84,3 +101,8 @@ def bd():
 @pytest.fixture
 def rpy():
     return flyft.dynamics.RPYDiffusiveFlux()
+
+
+@pytest.fixture
+def piccard():
+    return flyft.solver.PicardIteration(0.1, 1000, 1.0e-8)
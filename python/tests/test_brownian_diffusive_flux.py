@@ -183,3 +183,74 @@ def test_external(state, grand, ig, walls, linear, bd):
     grand.external.append(linear)
     bd.compute(grand, state)
     assert np.allclose(bd.fluxes["A"][flags], 3.0 * 2.0 * -0.25)
+
+
+@pytest.mark.parametrize(
+    "lo,hi,diameter", [(2.0, 8.0, 1.0), (0.0, 10.0, 0.2), (0.0, 10.0, 30.0)]
+)
+def test_active_range(
+    grand, ig, fmt, linear, bd, cartesian_mesh_grand, lo, hi, diameter
+):
+    # the fused explicit update skips the points outside the active range of the
+    # walls, which must not change the result: check one step against the full update,
+    # including when the range reaches the edges that are exchanged or is empty
+    state = flyft.State(flyft.state.ParallelMesh(cartesian_mesh_grand), ("A",))
+    walls = (flyft.external.HardWall(lo, 1.0), flyft.external.HardWall(hi, -1.0))
+    for w in walls:
+        w.diameters["A"] = diameter
+    linear.set_line("A", x=0.0, y=0.0, slope=0.25)
+    ig.volumes["A"] = 1.0
+    fmt.diameters["A"] = 1.0
+    grand.ideal = ig
+    grand.excess = fmt
+    grand.external = flyft.external.CompositeExternalPotential(walls + (linear,))
+    grand.constrain("A", -1.0, grand.Constraint.mu)
+    bd.diffusivities["A"] = 2.0
+
+    grand.external.compute(state)
+    V = grand.external.derivatives["A"].data.copy()
+    x = state.mesh.local.centers
+    state.fields["A"][:] = np.where(np.isinf(V), 0.0, 0.2 * (1 + 0.5 * np.sin(x)))
+    rho = state.fields["A"].data.copy()
+    fmt.compute(state)
+    mu_ex = fmt.derivatives["A"].data.copy()
+
+    # there is no flux across an edge touching a point where the potential is infinite
+    step = state.mesh.full.step
+    blocked = np.logical_or(np.isinf(V), np.isinf(np.roll(V, 1)))
+    with np.errstate(invalid="ignore"):
+        dmu = (mu_ex - np.roll(mu_ex, 1)) + (V - np.roll(V, 1))
+        rho_edge = 0.5 * (rho + np.roll(rho, 1))
+        j = -2.0 * ((rho - np.roll(rho, 1)) + rho_edge * dmu) / step
+    j[blocked] = 0.0
+    expected = rho + 1.0e-3 * (j - np.roll(j, -1)) / step
+
+    euler = flyft.dynamics.ExplicitEulerIntegrator(1.0e-3)
+    euler.advance(bd, grand, state, euler.timestep)
+    assert np.allclose(state.fields["A"].data, expected, rtol=0, atol=1e-12)
+    assert np.all(state.fields["A"][np.isinf(V)] == 0.0)
+
+
+def test_nonuniform_mesh(grand, ig, linear, bd):
+    # the gradient is taken between the centers of bins of different widths, and the
+    # density is interpolated linearly onto the edge between them
+    edges = 5.0 * np.linspace(0.0, 1.0, 41) ** 2
+    mesh = flyft.state.NonuniformCartesianMesh(edges, "periodic")
+    state = flyft.State(flyft.state.ParallelMesh(mesh), ("A",))
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 1.0 + 0.5 * x
+    ig.volumes["A"] = 1.0
+    grand.ideal = ig
+    grand.constrain("A", 0.0, grand.Constraint.mu)
+    linear.set_line("A", x=0.0, y=0.0, slope=0.25)
+    grand.external = linear
+    bd.diffusivities["A"] = 2.0
+    bd.compute(grand, state)
+
+    # j = -D (drho/dx + rho dV/dx), skipping the jump over the periodic boundary
+    lower = np.array(
+        [state.mesh.local.lower_bound(i) for i in range(state.mesh.local.shape)]
+    )
+    flags = lower > edges[0]
+    j = -2.0 * (0.5 + (1.0 + 0.5 * lower) * 0.25)
+    assert np.allclose(bd.fluxes["A"][flags], j[flags])
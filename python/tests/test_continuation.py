@@ -0,0 +1,113 @@
+import numpy as np
+import pytest
+
+import flyft
+
+from .test_ideal_gas import mu_ig
+
+
+@pytest.fixture
+def continuation(piccard):
+    return flyft.solver.Continuation(piccard)
+
+
+def test_init(continuation, piccard):
+    assert continuation.solver is piccard
+    assert continuation.predictor == continuation.Predictor.secant
+    assert continuation.control_type == ""
+    assert continuation.num_solutions == 0
+
+    # change solver
+    piccard2 = flyft.solver.PicardIteration(0.05, 100, 1.0e-6)
+    continuation.solver = piccard2
+    assert continuation.solver is piccard2
+    assert continuation._self.solver is piccard2._self
+
+    # change predictor
+    continuation.predictor = continuation.Predictor.quadratic
+    assert continuation.predictor == continuation.Predictor.quadratic
+    assert continuation._self.predictor == continuation.Predictor.quadratic
+
+    # change control type
+    continuation.control_type = "A"
+    assert continuation.control_type == "A"
+    assert continuation._self.control_type == "A"
+
+
+@pytest.mark.parametrize("predictor", ["none", "secant", "quadratic"])
+def test_sweep_mu(continuation, predictor, ideal_walls, inside_walls, state):
+    continuation.predictor = getattr(continuation.Predictor, predictor)
+    continuation.control_type = "A"
+    grand = ideal_walls
+    grand.constrain("A", mu_ig(0.1, 1.0), grand.Constraint.mu)
+
+    for i, rho in enumerate((0.1, 0.15, 0.2, 0.25, 0.3)):
+        assert continuation.solve(grand, state, mu_ig(rho, 1.0))
+        assert grand.constraints["A"] == pytest.approx(mu_ig(rho, 1.0))
+        assert continuation.num_solutions == min(i + 1, 3)
+        assert np.allclose(state.fields["A"][inside_walls], rho, atol=1e-5)
+        assert np.allclose(state.fields["A"][~inside_walls], 0.0, atol=1e-5)
+
+    # solving a different state discards the stored solutions
+    state2 = flyft.State(state.mesh, ("A",))
+    assert continuation.solve(grand, state2, mu_ig(0.2, 1.0))
+    assert continuation.num_solutions == 1
+    assert np.allclose(state2.fields["A"][inside_walls], 0.2, atol=1e-5)
+
+    continuation.reset()
+    assert continuation.num_solutions == 0
+
+
+@pytest.mark.parametrize("predictor", ["secant", "quadratic"])
+def test_predict(continuation, piccard, predictor, ideal_walls, state):
+    continuation.predictor = getattr(continuation.Predictor, predictor)
+    continuation.control_type = "A"
+    grand = ideal_walls
+    grand.constrain("A", mu_ig(0.1, 1.0), grand.Constraint.mu)
+
+    # a solver without iterations leaves the predicted densities in the state
+    guess = flyft.solver.PicardIteration(0.1, 0, 1.0e-8)
+    order = 1 if predictor == "secant" else 2
+    values = []
+    fields = []
+    for rho in (0.1, 0.15, 0.2, 0.25, 0.3):
+        mu = mu_ig(rho, 1.0)
+        if len(values) >= 2:
+            continuation.solver = guess
+            assert not continuation.solve(grand, state, mu)
+            assert continuation.num_solutions == min(len(values), 3)
+
+            # Lagrange extrapolation through the most recent solutions
+            xs = values[-min(order + 1, len(values)) :]
+            ys = fields[-len(xs) :]
+            predicted = np.zeros_like(ys[0])
+            for j, (x_j, y_j) in enumerate(zip(xs, ys)):
+                weight = np.prod([(mu - x_m) / (x_j - x_m) for x_m in xs if x_m != x_j])
+                predicted += weight * y_j
+            assert np.allclose(state.fields["A"], np.maximum(predicted, 0.0))
+            continuation.solver = piccard
+
+        assert continuation.solve(grand, state, mu)
+        values.append(mu)
+        fields.append(np.array(state.fields["A"]))
+
+
+def test_sweep_time(continuation, grand, walls, state):
+    rho = 0.1
+    grand.ideal = flyft.functional.IdealGas()
+    grand.ideal.volumes["A"] = 1.0
+    grand.constrain("A", mu_ig(rho, 1.0), grand.Constraint.mu)
+
+    # lower wall moves with time
+    walls[0].origin = flyft.parameter.LinearParameter(1.0, 0.0, 1.0)
+    for w in walls:
+        w.diameters["A"] = 0.0
+    grand.external = flyft.external.CompositeExternalPotential(walls)
+
+    x = state.mesh.local.centers
+    for time in (0.0, 0.5, 1.0, 1.5):
+        assert continuation.solve(grand, state, time)
+        assert state.time == pytest.approx(time)
+        flags = np.logical_and(x > 1.0 + time, x <= 9.0)
+        assert np.allclose(state.fields["A"][flags], rho, atol=1e-5)
+        assert np.allclose(state.fields["A"][~flags], 0.0, atol=1e-5)
@@ -34,6 +34,15 @@ def test_init(cn):
     assert cn.tolerance == pytest.approx(1.0e-7)
     assert cn._self.tolerance == pytest.approx(1.0e-7)
 
+    # change nonlinear solver
+    assert cn.method == cn.Method.fixed_point
+    cn.method = cn.Method.newton_krylov
+    assert cn.method == cn.Method.newton_krylov
+    cn.krylov_dimension = 10
+    assert cn.krylov_dimension == 10
+    cn.krylov_tolerance = 1.0e-4
+    assert cn.krylov_tolerance == pytest.approx(1.0e-4)
+
 
 def test_advance(state, grand, ig, linear, bd, cn):
     ig.volumes["A"] = 1.0
@@ -104,3 +113,37 @@ def test_sine(adapt, cn, state_sine):
     if isinstance(state.mesh.full, flyft.state.CartesianMesh):
         sol = 0.5 * np.exp(-t / tau) * np.sin(2 * np.pi * x / state.mesh.full.L) + 1
         assert np.allclose(state.fields["A"], sol, atol=1.0e-4)
+
+
+def test_sine_newton_krylov(cn, state_sine):
+    state = state_sine
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 0.5 * np.sin(2 * np.pi * x / state.mesh.full.L) + 1.0
+
+    ig = flyft.functional.IdealGas()
+    ig.volumes["A"] = 1.0
+    grand = flyft.functional.GrandPotential(ig)
+    grand.constrain("A", 1.0 * state.mesh.full.L, grand.Constraint.N)
+
+    bd = flyft.dynamics.BrownianDiffusiveFlux()
+    bd.diffusivities["A"] = 0.5
+
+    # timestep is too large for fixed-point iteration to converge
+    cn.max_iterations = 10
+    cn.timestep = 1.0e-3
+
+    tau = state.mesh.full.L**2 / (4 * np.pi**2 * bd.diffusivities["A"])
+    t = 1.5 * tau
+    sol = 0.5 * np.exp(-t / tau) * np.sin(2 * np.pi * x / state.mesh.full.L) + 1
+    cn.advance(bd, grand, state, t)
+    if isinstance(state.mesh.full, flyft.state.CartesianMesh):
+        assert not np.allclose(state.fields["A"], sol, atol=1.0e-4)
+
+    # Newton-Krylov converges with the same timestep
+    state.fields["A"][:] = 0.5 * np.sin(2 * np.pi * x / state.mesh.full.L) + 1.0
+    state.time = 0.0
+    cn.method = cn.Method.newton_krylov
+    cn.advance(bd, grand, state, t)
+    assert state.time == pytest.approx(t)
+    if isinstance(state.mesh.full, flyft.state.CartesianMesh):
+        assert np.allclose(state.fields["A"], sol, atol=1.0e-4)
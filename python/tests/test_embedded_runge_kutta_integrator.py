@@ -0,0 +1,149 @@
+import numpy as np
+import pytest
+
+import flyft
+
+
+class CountingFunctional(flyft._flyft.Functional):
+    """Functional that is zero everywhere and counts how often it is evaluated"""
+
+    def __init__(self):
+        super().__init__()
+        self.calls = 0
+
+    def _compute(self, state, compute_value):
+        self.calls += 1
+
+
+@pytest.fixture(
+    params=[
+        (flyft.dynamics.BogackiShampineIntegrator, 3, 4),
+        (flyft.dynamics.DormandPrinceIntegrator, 5, 7),
+    ],
+    ids=["bogacki_shampine", "dormand_prince"],
+)
+def tableau(request):
+    return request.param
+
+
+@pytest.fixture
+def integrator(tableau):
+    return tableau[0](1.0e-3)
+
+
+def test_timestep(integrator):
+    assert integrator.timestep == pytest.approx(1.0e-3)
+
+    integrator.timestep = 1.0e-2
+    assert integrator.timestep == pytest.approx(1.0e-2)
+
+
+def test_advance(state, grand, ig, bd, integrator):
+    ig.volumes["A"] = 1.0
+    grand.ideal = ig
+    bd.diffusivities["A"] = 2.0
+
+    # all ones should not change
+    state.fields["A"][:] = 1.0
+    grand.constrain("A", 1.0 * state.mesh.full.L, grand.Constraint.N)
+    integrator.advance(bd, grand, state, integrator.timestep)
+    assert state.time == pytest.approx(1.0e-3)
+    assert np.allclose(state.fields["A"], 1.0)
+    integrator.advance(bd, grand, state, -integrator.timestep)
+    assert state.time == pytest.approx(0.0)
+    assert np.allclose(state.fields["A"], 1.0)
+
+    # run forwards for a partial step
+    integrator.advance(bd, grand, state, 1.5e-4)
+    assert state.time == pytest.approx(1.5e-4)
+    integrator.advance(bd, grand, state, -1.5e-4)
+    assert state.time == pytest.approx(0.0)
+
+
+@pytest.mark.parametrize("adapt", [False, True])
+def test_sine(adapt, integrator, state_sine):
+    state = state_sine
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 0.5 * np.sin(2 * np.pi * x / state.mesh.full.L) + 1.0
+
+    ig = flyft.functional.IdealGas()
+    ig.volumes["A"] = 1.0
+    grand = flyft.functional.GrandPotential(ig)
+    grand.constrain("A", 1.0 * state.mesh.full.L, grand.Constraint.N)
+
+    bd = flyft.dynamics.BrownianDiffusiveFlux()
+    bd.diffusivities["A"] = 0.5
+
+    if adapt:
+        integrator.adaptive = True
+    else:
+        integrator.adaptive = False
+        integrator.timestep = 1.0e-4
+
+    tau = state.mesh.full.L**2 / (4 * np.pi**2 * bd.diffusivities["A"])
+    t = 1.5 * tau
+    integrator.advance(bd, grand, state, t)
+    assert state.time == pytest.approx(t)
+    if isinstance(state_sine.mesh.full, flyft.state.CartesianMesh):
+        sol = 0.5 * np.exp(-t / tau) * np.sin(2 * np.pi * x / state.mesh.full.L) + 1
+        assert np.allclose(state.fields["A"], sol, atol=1.0e-4)
+
+
+def test_order(tableau, ig, bd):
+    # ideal-gas diffusion on a periodic mesh is a linear system of ODEs, and each sine
+    # mode decays exactly at the rate of the discrete second derivative, so halving the
+    # step should cut the error of the higher-order solution by 2 to the order
+    L = 10.0
+    N = 20
+    mesh = flyft.state.CartesianMesh(L, N, "periodic", 1.0)
+    dx = L / N
+    q = 6 * np.pi / L
+    ig.volumes["A"] = 1.0
+    grand = flyft.functional.GrandPotential(ig)
+    grand.constrain("A", L, grand.Constraint.N)
+    bd.diffusivities["A"] = 0.5
+    rate = -4 * bd.diffusivities["A"] * np.sin(q * dx / 2) ** 2 / dx**2
+
+    # the steps divide the time exactly so every step has the same size
+    t = 1.0
+    steps = np.array([8, 16, 32])
+    errors = []
+    for n in steps:
+        state = flyft.State(flyft.state.ParallelMesh(mesh), ("A",))
+        x = state.mesh.local.centers
+        state.fields["A"][:] = 1.0 + 0.5 * np.sin(q * x)
+
+        integrator = tableau[0](t / n)
+        integrator.adaptive = False
+        integrator.advance(bd, grand, state, t)
+        sol = 1.0 + 0.5 * np.exp(rate * t) * np.sin(q * x)
+        errors.append(np.max(np.abs(state.fields["A"] - sol)))
+
+    slope = np.polyfit(np.log(1.0 / steps), np.log(errors), 1)[0]
+    assert slope == pytest.approx(tableau[1], abs=0.25)
+
+
+def test_fsal(tableau, integrator, ig, bd, state):
+    # the last stage of an accepted step is the first stage of the next, so only the
+    # first step of an advance evaluates every stage
+    _, _, stages = tableau
+    ig.volumes["A"] = 1.0
+    counter = CountingFunctional()
+    grand = flyft.functional.GrandPotential(ig, counter)
+    grand.constrain("A", 1.0 * state.mesh.full.L, grand.Constraint.N)
+    bd.diffusivities["A"] = 0.5
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 1.0 + 0.5 * np.sin(2 * np.pi * x / state.mesh.full.L)
+
+    # the step is a power of 2 so the steps divide the time exactly
+    integrator.timestep = 2.0**-10
+    integrator.adaptive = False
+    n = 4
+    integrator.advance(bd, grand, state, n * integrator.timestep)
+    assert counter.calls == 1 + (stages - 1) * n
+
+    # separate advances cannot reuse the last stage of the previous one
+    counter.calls = 0
+    for _ in range(n):
+        integrator.advance(bd, grand, state, integrator.timestep)
+    assert counter.calls == stages * n
@@ -0,0 +1,104 @@
+import numpy as np
+import pytest
+
+import flyft
+
+from .test_ideal_gas import mu_ig
+
+
+def make_system(state, rho):
+    grand = flyft.functional.GrandPotential()
+    grand.ideal = flyft.functional.IdealGas()
+    grand.ideal.volumes["A"] = 1.0
+    grand.constrain("A", mu_ig(rho, 1.0), grand.Constraint.mu)
+    return grand, flyft.State(state.mesh, ("A",))
+
+
+def test_systems(state):
+    ensemble = flyft.solver.Ensemble()
+    assert len(ensemble) == 0
+
+    systems = [make_system(state, rho) for rho in (0.1, 0.2, 0.3)]
+    for grand, state_ in systems:
+        ensemble.append(grand, state_)
+    assert len(ensemble) == 3
+    assert len(ensemble._self) == 3
+    assert ensemble[1][0] is systems[1][0]
+    assert ensemble[1][1] is systems[1][1]
+
+    # remove a system
+    del ensemble[1]
+    assert len(ensemble) == 2
+    assert ensemble[1][0] is systems[2][0]
+    assert ensemble._self.state(1) is systems[2][1]._self
+    with pytest.raises(IndexError):
+        ensemble._self.state(2)
+
+    # clear all systems
+    ensemble.clear()
+    assert len(ensemble) == 0
+    assert len(ensemble._self) == 0
+
+    # construct from systems
+    ensemble = flyft.solver.Ensemble(systems)
+    assert len(ensemble) == 3
+
+
+def test_solve(piccard, walls, ideal_walls, state):
+    densities = (0.1, 0.2, 0.3, 0.4)
+    ensemble = flyft.solver.Ensemble([make_system(state, rho) for rho in densities])
+
+    # solve in bulk
+    conv = ensemble.solve(piccard)
+    assert conv == [True] * len(densities)
+    for (grand, state_), rho in zip(ensemble, densities):
+        assert np.allclose(state_.fields["A"].data, rho, atol=1e-5)
+
+    # give each system its own walls, which should match a system solved by itself
+    for grand, state_ in ensemble:
+        ws = [flyft.external.HardWall(w.origin, w.normal) for w in walls]
+        for w in ws:
+            w.diameters["A"] = 0.0
+        grand.external = flyft.external.CompositeExternalPotential(ws)
+    conv = ensemble.solve(piccard)
+    assert all(conv)
+
+    grand = ideal_walls
+    grand.constrain("A", mu_ig(densities[-1], 1.0), grand.Constraint.mu)
+    state_ = flyft.State(state.mesh, ("A",))
+    assert piccard.solve(grand, state_)
+    assert np.allclose(ensemble[-1][1].fields["A"].data, state_.fields["A"].data)
+
+
+def test_shared_grand(piccard, state):
+    # systems sharing a grand potential are solved one after another
+    grand, _ = make_system(state, 0.2)
+    states = [flyft.State(state.mesh, ("A",)) for _ in range(3)]
+    ensemble = flyft.solver.Ensemble([(grand, s) for s in states])
+    assert all(ensemble.solve(piccard))
+    for s in states:
+        assert np.allclose(s.fields["A"].data, 0.2, atol=1e-5)
+
+
+def test_shared_child(piccard, walls, inside_walls, state):
+    # separate composites that share a wall are solved one after another
+    densities = (0.1, 0.2)
+    ensemble = flyft.solver.Ensemble([make_system(state, rho) for rho in densities])
+    for w in walls:
+        w.diameters["A"] = 0.0
+    for grand, _ in ensemble:
+        grand.external = flyft.external.CompositeExternalPotential(walls)
+    assert not ensemble.concurrent
+    assert all(ensemble.solve(piccard))
+
+    for (grand, state_), rho in zip(ensemble, densities):
+        assert np.allclose(state_.fields["A"][inside_walls], rho, atol=1e-5)
+        assert np.allclose(state_.fields["A"][~inside_walls], 0.0, atol=1e-5)
+
+    # giving each system its own walls makes them independent again
+    for grand, _ in ensemble:
+        ws = [flyft.external.HardWall(w.origin, w.normal) for w in walls]
+        for w in ws:
+            w.diameters["A"] = 0.0
+        grand.external = flyft.external.CompositeExternalPotential(ws)
+    assert ensemble.concurrent
@@ -100,7 +100,13 @@ def test_sine(adapt, euler, state_sine):
 
     tau = state.mesh.full.L**2 / (4 * np.pi**2 * bd.diffusivities["A"])
     t = 1.5 * tau
-    euler.advance(bd, grand, state, t)
+
+    # fields taken before advancing stay attached to the state
+    field = state.fields["A"]
+    for _ in range(3):
+        euler.advance(bd, grand, state, t / 3)
+        assert state.fields["A"]._self is field._self
+        assert np.array_equal(field.data, state.fields["A"].data)
     if isinstance(state_sine.mesh.full, flyft.state.CartesianMesh):
         sol = 0.5 * np.exp(-t / tau) * np.sin(2 * np.pi * x / state.mesh.full.L) + 1
         assert np.allclose(state.fields["A"], sol, atol=1.0e-4)
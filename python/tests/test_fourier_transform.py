@@ -0,0 +1,70 @@
+import numpy as np
+import pytest
+
+import flyft
+
+Symmetry = flyft._flyft.FourierTransform.Symmetry
+
+
+@pytest.mark.parametrize(
+    "symmetry",
+    [
+        Symmetry.periodic,
+        Symmetry.even,
+        Symmetry.odd,
+        Symmetry.odd_even,
+        Symmetry.even_odd,
+    ],
+)
+@pytest.mark.parametrize("pad", [False, True])
+def test_round_trip(symmetry, pad):
+    ft = flyft._flyft.FourierTransform(5.0, 101, symmetry, pad)
+    assert ft.N == 101
+    assert ft.padded_N == (105 if pad else 101)
+    assert ft.symmetry == symmetry
+
+    rng = np.random.default_rng(42)
+    f = rng.uniform(-1.0, 1.0, 101)
+    ft.real = f
+    ft.transform()
+    ft.transform()
+    assert np.allclose(ft.real, f, rtol=0, atol=1e-12)
+
+
+@pytest.mark.parametrize(
+    "symmetry,basis,offset",
+    [
+        (Symmetry.even, np.cos, 0),
+        (Symmetry.odd, np.sin, 1),
+        (Symmetry.odd_even, np.sin, 0.5),
+        (Symmetry.even_odd, np.cos, 0.5),
+    ],
+)
+def test_coefficients(symmetry, basis, offset):
+    L = 5.0
+    N = 101
+    ft = flyft._flyft.FourierTransform(L, N, symmetry, False)
+    k = np.array(ft.wavevectors)
+    assert len(k) == N
+    assert np.allclose(k, (np.arange(N) + offset) * np.pi / L)
+
+    # each mode at the centers of the points, halfway between the ends and their images,
+    # has a single coefficient
+    x = (np.arange(N) + 0.5) * L / N
+    j = 3
+    f = basis(k[j] * x)
+    ft.real = f
+    ft.transform()
+    c = np.zeros(N)
+    c[j] = N
+    assert np.allclose(ft.coefficients, c, rtol=0, atol=1e-10)
+
+    # setting the coefficients directly gives back the mode, normalized by 2N
+    ft.coefficients = c
+    ft.transform()
+    assert np.allclose(ft.real, f, rtol=0, atol=1e-12)
+
+    with pytest.raises(ValueError):
+        ft.real = f[:-1]
+    with pytest.raises(ValueError):
+        ft.coefficients = c[:-1]
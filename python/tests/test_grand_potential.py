@@ -107,3 +107,24 @@ def test_compute(grand, state):
     assert np.allclose(
         grand.derivatives["A"].data, mu_ig(rho, 1.0) + muex_py(eta) - mu_bulk, atol=1e-2
     )
+
+
+def test_mu_with_buffer(grand, bd, state):
+    # a flux requests a buffer on the derivatives, and the chemical potential must still
+    # be subtracted from every point of the mesh, including the last ones
+    grand.ideal = flyft.functional.IdealGas()
+    grand.ideal.volumes["A"] = 1.0
+    mu_bulk = 0.5
+    grand.constrain("A", mu_bulk, grand.Constraint.mu)
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 0.1 * (1 + 0.5 * np.sin(x))
+
+    bd.diffusivities["A"] = 1.0
+    bd.compute(grand, state)
+    grand.compute(state)
+    assert np.allclose(
+        grand.derivatives["A"].data, grand.ideal.derivatives["A"].data - mu_bulk
+    )
+    assert grand.derivatives["A"][-1] == pytest.approx(
+        mu_ig(state.fields["A"][-1], 1.0) - mu_bulk
+    )
@@ -94,3 +94,84 @@ def test_potential(hw, state):
     assert hw.value == pytest.approx(0.0)
     assert np.allclose(hw.derivatives["A"][x <= 1.5], 0.0)
     assert np.all(hw.derivatives["A"][x > 1.5] == np.inf)
+
+
+def test_active_range(state):
+    # a slit between two walls is only accessible between their contact planes
+    lo = flyft.external.HardWall(2.0, 1.0)
+    hi = flyft.external.HardWall(8.0, -1.0)
+    slit = flyft.external.CompositeExternalPotential([lo, hi])
+    lo.diameters["A"] = 1.0
+    hi.diameters["A"] = 1.0
+    state.fields["A"][:] = 0.0
+    shape = state.mesh.local.shape
+    x = state.mesh.local.centers
+
+    # the range is only known once the potential has been evaluated
+    with pytest.raises(RuntimeError):
+        slit.active_range("A")
+
+    slit.compute(state)
+    first = np.count_nonzero(x <= 2.5)
+    last = shape - np.count_nonzero(x >= 7.5)
+    assert slit.active_range("A") == (first, last)
+    assert lo.active_range("A") == (first, shape)
+    assert hi.active_range("A") == (0, last)
+
+    # the range follows the potential when a wall changes
+    lo.diameters["A"] = 3.0
+    slit.compute(state)
+    assert slit.active_range("A") == (np.count_nonzero(x <= 3.5), last)
+
+    # walls that cover the whole mesh leave no points
+    lo.diameters["A"] = 30.0
+    slit.compute(state)
+    assert slit.active_range("A") == (shape, shape)
+
+
+def test_boltzmann_factor(hw, linear, state):
+    hw.diameters["A"] = 1.0
+    state.fields["A"][:] = 0.0
+    x = state.mesh.local.centers
+
+    # the factor is only known once the potential has been evaluated
+    with pytest.raises(RuntimeError):
+        hw.boltzmann_factor("A")
+
+    # the factor is exactly zero where the potential is infinite
+    hw.compute(state)
+    b = hw.boltzmann_factor("A").data
+    assert np.all(b[x <= 2.5] == 0.0)
+    assert np.all(b[x > 2.5] == 1.0)
+
+    # the factor is a copy, so changing it leaves the cached factor alone
+    b[:] = 2.0
+    b = hw.boltzmann_factor("A").data
+    assert np.all(b[x <= 2.5] == 0.0)
+    assert np.all(b[x > 2.5] == 1.0)
+
+    # moving the wall or changing its diameter evaluates the factor again
+    hw.origin = 4.0
+    hw.compute(state)
+    b = hw.boltzmann_factor("A").data
+    assert np.all(b[x <= 4.5] == 0.0)
+    assert np.all(b[x > 4.5] == 1.0)
+
+    hw.diameters["A"] = 2.0
+    hw.compute(state)
+    b = hw.boltzmann_factor("A").data
+    assert np.all(b[x <= 5.0] == 0.0)
+    assert np.all(b[x > 5.0] == 1.0)
+
+    # combined with a finite potential, the factor is exp(-V) of the total
+    linear.set_line("A", x=0.0, y=0.0, slope=0.25)
+    Vext = flyft.external.CompositeExternalPotential([hw, linear])
+    Vext.compute(state)
+    b = Vext.boltzmann_factor("A").data
+    assert np.all(b[x <= 5.0] == 0.0)
+    assert np.allclose(b[x > 5.0], np.exp(-0.25 * x[x > 5.0]))
+
+    linear.slopes["A"] = 0.5
+    Vext.compute(state)
+    b = Vext.boltzmann_factor("A").data
+    assert np.allclose(b[x > 5.0], np.exp(-0.5 * x[x > 5.0]))
@@ -0,0 +1,70 @@
+import numpy as np
+import pytest
+
+import flyft
+
+
+@pytest.fixture
+def imex():
+    return flyft.dynamics.IMEXEulerIntegrator(1.0e-3)
+
+
+def test_timestep(imex):
+    assert imex.timestep == pytest.approx(1.0e-3)
+
+    imex.timestep = 1.0e-2
+    assert imex.timestep == pytest.approx(1.0e-2)
+
+
+def test_advance(state, grand, ig, bd, imex):
+    ig.volumes["A"] = 1.0
+    grand.ideal = ig
+    bd.diffusivities["A"] = 2.0
+
+    # all ones should not change
+    state.fields["A"][:] = 1.0
+    grand.constrain("A", 1.0 * state.mesh.full.L, grand.Constraint.N)
+    imex.advance(bd, grand, state, imex.timestep)
+    assert state.time == pytest.approx(1.0e-3)
+    assert np.allclose(state.fields["A"], 1.0)
+    imex.advance(bd, grand, state, -imex.timestep)
+    assert state.time == pytest.approx(0.0)
+    assert np.allclose(state.fields["A"], 1.0)
+
+
+def test_flux_type(state, grand, ig, rpy, imex):
+    ig.volumes["A"] = 1.0
+    grand.ideal = ig
+    grand.constrain("A", 1.0 * state.mesh.full.L, grand.Constraint.N)
+    with pytest.raises(ValueError):
+        imex.advance(rpy, grand, state, imex.timestep)
+
+
+@pytest.mark.parametrize("adapt", [False, True])
+def test_sine(adapt, imex, state_sine):
+    state = state_sine
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 0.5 * np.sin(2 * np.pi * x / state.mesh.full.L) + 1.0
+
+    ig = flyft.functional.IdealGas()
+    ig.volumes["A"] = 1.0
+    grand = flyft.functional.GrandPotential(ig)
+    grand.constrain("A", 1.0 * state.mesh.full.L, grand.Constraint.N)
+
+    bd = flyft.dynamics.BrownianDiffusiveFlux()
+    bd.diffusivities["A"] = 0.5
+
+    # timestep is well beyond the explicit stability limit
+    if adapt:
+        imex.adaptive = True
+    else:
+        imex.adaptive = False
+        imex.timestep = 1.0e-3
+
+    tau = state.mesh.full.L**2 / (4 * np.pi**2 * bd.diffusivities["A"])
+    t = 1.5 * tau
+    imex.advance(bd, grand, state, t)
+    assert state.time == pytest.approx(t)
+    if isinstance(state_sine.mesh.full, flyft.state.CartesianMesh):
+        sol = 0.5 * np.exp(-t / tau) * np.sin(2 * np.pi * x / state.mesh.full.L) + 1
+        assert np.allclose(state.fields["A"], sol, atol=1.0e-3)
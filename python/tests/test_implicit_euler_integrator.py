@@ -34,6 +34,15 @@ def test_init(euler):
     assert euler.tolerance == pytest.approx(1.0e-7)
     assert euler._self.tolerance == pytest.approx(1.0e-7)
 
+    # change nonlinear solver
+    assert euler.method == euler.Method.fixed_point
+    euler.method = euler.Method.newton_krylov
+    assert euler.method == euler.Method.newton_krylov
+    euler.krylov_dimension = 10
+    assert euler.krylov_dimension == 10
+    euler.krylov_tolerance = 1.0e-4
+    assert euler.krylov_tolerance == pytest.approx(1.0e-4)
+
 
 def test_advance(state, grand, ig, linear, bd, euler):
     ig.volumes["A"] = 1.0
@@ -103,3 +112,29 @@ def test_sine(adapt, state_sine, euler):
     if isinstance(state_sine.mesh.full, flyft.state.CartesianMesh):
         sol = 0.5 * np.exp(-t / tau) * np.sin(2 * np.pi * x / state.mesh.full.L) + 1
         assert np.allclose(state.fields["A"], sol, atol=1.0e-4)
+
+
+def test_sine_newton_krylov(euler, state_sine):
+    state = state_sine
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 0.5 * np.sin(2 * np.pi * x / state.mesh.full.L) + 1.0
+
+    ig = flyft.functional.IdealGas()
+    ig.volumes["A"] = 1.0
+    grand = flyft.functional.GrandPotential(ig)
+    grand.constrain("A", 1.0 * state.mesh.full.L, grand.Constraint.N)
+
+    bd = flyft.dynamics.BrownianDiffusiveFlux()
+    bd.diffusivities["A"] = 0.5
+
+    euler.method = euler.Method.newton_krylov
+    euler.max_iterations = 10
+    euler.timestep = 5.0e-5
+
+    tau = state.mesh.full.L**2 / (4 * np.pi**2 * bd.diffusivities["A"])
+    t = 1.5 * tau
+    euler.advance(bd, grand, state, t)
+    assert state.time == pytest.approx(t)
+    if isinstance(state.mesh.full, flyft.state.CartesianMesh):
+        sol = 0.5 * np.exp(-t / tau) * np.sin(2 * np.pi * x / state.mesh.full.L) + 1
+        assert np.allclose(state.fields["A"], sol, atol=1.0e-4)
@@ -1,5 +1,8 @@
+import numpy as np
 import pytest
 
+import flyft
+
 
 def test_init(mesh):
     assert mesh.L == 10.0
@@ -33,7 +36,88 @@ def test_volume_cartesian(cartesian_mesh):
     assert cartesian_mesh.volume(0) == pytest.approx(0.1)
 
 
+def test_bin(mesh):
+    assert mesh._self.bin(0.0) == 0
+    assert mesh._self.bin(0.55) == 5
+    assert mesh._self.bin(9.95) == 99
+
+    # positions below the mesh round down into the buffer bins
+    assert mesh._self.bin(-0.05) == -1
+    assert mesh._self.bin(-0.15) == -2
+
+
+def test_fast_shape():
+    assert flyft.state.CartesianMesh.fast_shape(1) == 1
+    assert flyft.state.CartesianMesh.fast_shape(100) == 100
+    assert flyft.state.CartesianMesh.fast_shape(101) == 105
+    assert flyft.state.CartesianMesh.fast_shape(127) == 128
+
+
 def test_volume_spherical(spherical_mesh):
     assert spherical_mesh.lower_boundary_condition == "reflect"
     assert spherical_mesh.volume() == pytest.approx(4188.790204786391)
     assert spherical_mesh.volume(0) == pytest.approx(0.0041, abs=1e-3)
+
+
+def test_nonuniform_cartesian():
+    edges = [0.0, 0.5, 1.5, 3.0]
+    mesh = flyft.state.NonuniformCartesianMesh(edges, "periodic", 2.0)
+    assert mesh.shape == 3
+    assert mesh.L == pytest.approx(3.0)
+    assert mesh.step == pytest.approx(0.5)
+    assert np.allclose(mesh.edges, edges)
+    assert mesh.lower_bound() == pytest.approx(0.0)
+    assert mesh.upper_bound() == pytest.approx(3.0)
+    assert np.allclose(mesh.centers, [0.25, 1.0, 2.25])
+    assert mesh.volume() == pytest.approx(6.0)
+    assert mesh.volume(1) == pytest.approx(2.0)
+    assert mesh.lower_bound(2) == pytest.approx(1.5)
+    assert mesh.upper_bound(2) == pytest.approx(3.0)
+    assert mesh._self.bin(1.0) == 1
+    assert mesh._self.bin(2.9) == 2
+
+    # bins outside the mesh wrap around for periodic boundaries
+    assert mesh.lower_bound(-1) == pytest.approx(-1.5)
+    assert mesh.upper_bound(3) == pytest.approx(3.5)
+
+    # and mirror otherwise
+    mesh = flyft.state.NonuniformCartesianMesh(edges, "reflect")
+    assert mesh.lower_bound(-1) == pytest.approx(-0.5)
+    assert mesh.upper_bound(3) == pytest.approx(4.5)
+
+    # edges must be increasing
+    with pytest.raises(ValueError):
+        flyft.state.NonuniformCartesianMesh([0.0, 1.0, 1.0], "reflect")
+
+
+@pytest.mark.parametrize("boundary_condition", ["periodic", "reflect"])
+def test_nonuniform_cartesian_bin(boundary_condition):
+    mesh = flyft.state.NonuniformCartesianMesh([0.0, 0.5, 1.5, 3.0], boundary_condition)
+
+    # bins are found from the same wrapped or mirrored edges as the bounds, also for
+    # bins outside the mesh
+    for i in range(-2 * mesh.shape, 2 * mesh.shape):
+        lo = mesh.lower_bound(i)
+        hi = mesh.upper_bound(i)
+        assert mesh._self.bin(lo) == i
+        assert mesh._self.bin(0.5 * (lo + hi)) == i
+        assert mesh._self.bin(np.nextafter(hi, lo)) == i
+
+
+def test_nonuniform_cartesian_parallel():
+    edges = 5.0 * np.linspace(0.0, 1.0, 41) ** 2
+    mesh = flyft.state.NonuniformCartesianMesh(edges, "periodic")
+    local = flyft.state.ParallelMesh(mesh).local
+    assert np.allclose(local.edges, edges)
+
+    # the local bins, including the buffers, are a run of the bins of the entire mesh
+    start = int(np.argmin(np.abs(edges - local.lower_bound(0))))
+    bins = range(-2, local.shape + 2)
+    assert np.allclose(
+        [local.lower_bound(i) for i in bins],
+        [mesh.lower_bound(start + i) for i in bins],
+    )
+    assert np.allclose(
+        [local.volume(i) for i in bins], [mesh.volume(start + i) for i in bins]
+    )
+    assert all(local._self.bin(local._self.center(i)) == i for i in bins)
@@ -0,0 +1,82 @@
+import numpy as np
+import pytest
+
+import flyft
+
+from .test_ideal_gas import mu_ig
+
+
+@pytest.fixture
+def multilevel(piccard):
+    return flyft.solver.MultilevelSolver(piccard, 3, 16)
+
+
+def test_init(multilevel, piccard):
+    assert multilevel.solver is piccard
+    assert multilevel.num_levels == 3
+    assert multilevel.min_shape == 16
+
+    # change solver
+    piccard2 = flyft.solver.PicardIteration(0.05, 100, 1.0e-6)
+    multilevel.solver = piccard2
+    assert multilevel.solver is piccard2
+    assert multilevel._self.solver is piccard2._self
+
+    # change levels
+    multilevel.num_levels = 2
+    assert multilevel.num_levels == 2
+    assert multilevel._self.num_levels == 2
+    with pytest.raises(ValueError):
+        multilevel.num_levels = 0
+
+    # change minimum shape
+    multilevel.min_shape = 8
+    assert multilevel.min_shape == 8
+    assert multilevel._self.min_shape == 8
+    with pytest.raises(ValueError):
+        multilevel.min_shape = 0
+
+
+def test_solve(multilevel, piccard, ideal_walls, inside_walls, state):
+    rho = 0.1
+    grand = ideal_walls
+    grand.constrain("A", mu_ig(rho, 1.0), grand.Constraint.mu)
+
+    assert multilevel.solve(grand, state)
+    assert np.allclose(state.fields["A"][inside_walls], rho, atol=1e-5)
+    assert np.allclose(state.fields["A"][~inside_walls], 0.0, atol=1e-5)
+
+    # the solution should match a solve on the mesh alone
+    state2 = flyft.State(state.mesh, ("A",))
+    assert piccard.solve(grand, state2)
+    assert np.allclose(state.fields["A"].data, state2.fields["A"].data, atol=1e-6)
+
+
+def test_restrict_prolong(multilevel, piccard, grand, state):
+    # without iterations, the densities are only averaged onto the coarse level and
+    # interpolated back onto the mesh of the state
+    multilevel.num_levels = 2
+    piccard.max_iterations = 0
+    mesh = state.mesh.full
+    L = mesh.L
+
+    def f(x):
+        return 1.0 + 0.5 * np.sin(2 * np.pi * x / L)
+
+    x = state.mesh.local.centers
+    state.fields["A"][:] = f(x)
+    assert not multilevel.solve(grand, state)
+
+    # each coarse point averages two points by volume
+    full_x = mesh.centers
+    volumes = np.array([mesh.volume(i) for i in range(mesh.shape)])
+    coarse_x = np.mean(full_x.reshape(-1, 2), axis=1)
+    coarse_volumes = volumes.reshape(-1, 2)
+    coarse_rho = np.sum(coarse_volumes * f(full_x).reshape(-1, 2), axis=1)
+    coarse_rho /= np.sum(coarse_volumes, axis=1)
+
+    # interpolation between the coarse points, skipping the edges
+    flags = np.logical_and(x > coarse_x[0], x < coarse_x[-1])
+    assert np.allclose(
+        state.fields["A"][flags], np.interp(x[flags], coarse_x, coarse_rho)
+    )
@@ -7,15 +7,10 @@ from .test_ideal_gas import mu_ig
 from .test_rosenfeld_fmt import muex_py
 
 
-@pytest.fixture
-def piccard():
-    return flyft.solver.PicardIteration(0.1, 100, 1.0e-6)
-
-
 def test_init(piccard):
     assert piccard.mix_parameter == pytest.approx(0.1)
-    assert piccard.max_iterations == 100
-    assert piccard.tolerance == pytest.approx(1.0e-6)
+    assert piccard.max_iterations == 1000
+    assert piccard.tolerance == pytest.approx(1.0e-8)
 
     # change mix param
     piccard.mix_parameter = 0.05
@@ -33,7 +28,7 @@ def test_init(piccard):
     assert piccard._self.tolerance == pytest.approx(1.0e-7)
 
 
-def test_solve(piccard, grand, fmt, walls, state):
+def test_solve(piccard, grand, fmt, walls, inside_walls, state):
     rho = 0.1
     grand.ideal = flyft.functional.IdealGas()
     grand.ideal.volumes["A"] = 1.0
@@ -51,10 +46,8 @@ def test_solve(piccard, grand, fmt, walls, state):
     grand.external = Vext
     conv = piccard.solve(grand, state)
     assert conv
-    x = state.mesh.local.centers
-    flags = np.logical_and(x > 1.0, x <= 9.0)
-    assert np.allclose(state.fields["A"][flags], rho, atol=1e-5)
-    assert np.allclose(state.fields["A"][~flags], 0.0, atol=1e-5)
+    assert np.allclose(state.fields["A"][inside_walls], rho, atol=1e-5)
+    assert np.allclose(state.fields["A"][~inside_walls], 0.0, atol=1e-5)
 
     # remove walls and do bulk hard spheres
     fmt.diameters["A"] = 1.0
@@ -88,5 +81,70 @@ def test_solve(piccard, grand, fmt, walls, state):
     grand.constrain("A", density * avail_vol, grand.Constraint.N)
     conv = piccard.solve(grand, state)
     assert conv
-    assert np.allclose(state.fields["A"][flags], density, atol=1e-3)
-    assert np.allclose(state.fields["A"][~flags], 0.0, atol=1e-3)
+    assert np.allclose(state.fields["A"][inside_walls], density, atol=1e-3)
+    assert np.allclose(state.fields["A"][~inside_walls], 0.0, atol=1e-3)
+
+
+@pytest.mark.parametrize(
+    "lo,hi,diameter", [(2.0, 8.0, 1.0), (0.0, 10.0, 0.2), (0.0, 10.0, 30.0)]
+)
+def test_active_range(piccard, grand, ig, fmt, lo, hi, diameter):
+    # only the points inside the active range of the walls are iterated, which must not
+    # change the result: check one mixing step against the full update
+    mesh = flyft.state.CartesianMesh(10.0, 100, "periodic", 1.0)
+    state = flyft.State(flyft.state.ParallelMesh(mesh), ("A",))
+    walls = (flyft.external.HardWall(lo, 1.0), flyft.external.HardWall(hi, -1.0))
+    for w in walls:
+        w.diameters["A"] = diameter
+    ig.volumes["A"] = 1.0
+    fmt.diameters["A"] = 1.0
+    grand.ideal = ig
+    grand.excess = fmt
+    grand.external = flyft.external.CompositeExternalPotential(walls)
+    grand.constrain("A", -1.0, grand.Constraint.mu)
+
+    grand.external.compute(state)
+    V = grand.external.derivatives["A"].data.copy()
+    x = state.mesh.local.centers
+    state.fields["A"][:] = np.where(np.isinf(V), 0.0, 0.2 * (1 + 0.5 * np.sin(x)))
+    rho = state.fields["A"].data.copy()
+    fmt.compute(state)
+    mu_ex = fmt.derivatives["A"].data.copy()
+
+    piccard.mix_parameter = 0.5
+    piccard.max_iterations = 1
+    piccard.solve(grand, state)
+    expected = 0.5 * rho + 0.5 * np.exp(-1.0 - mu_ex - V)
+    assert np.allclose(state.fields["A"].data, expected, rtol=0, atol=1e-12)
+    assert np.all(state.fields["A"][np.isinf(V)] == 0.0)
+
+
+def test_nonuniform_mesh(piccard, grand, ig):
+    # virial fluid against a Lennard-Jones wall on a mesh refined near the wall, where
+    # the local functional makes each point satisfy its own chemical potential
+    edges = 5.0 * np.linspace(0.0, 1.0, 41) ** 2
+    mesh = flyft.state.NonuniformCartesianMesh(edges, "reflect")
+    state = flyft.State(flyft.state.ParallelMesh(mesh), ("A",))
+    virial = flyft.functional.VirialExpansion()
+    virial.coefficients["A", "A"] = 0.5
+    lj = flyft.external.LennardJones93Wall(0.0, 1.0)
+    lj.epsilons["A"] = 1.0
+    lj.sigmas["A"] = 1.0
+    lj.cutoffs["A"] = 3.0
+    lj.shifts["A"] = True
+    ig.volumes["A"] = 1.0
+    grand.ideal = ig
+    grand.excess = virial
+    grand.external = lj
+    mu = mu_ig(0.2, 1.0) + 0.2
+    grand.constrain("A", mu, grand.Constraint.mu)
+
+    assert piccard.solve(grand, state)
+    virial.compute(state)
+    V = lj.derivatives["A"].data
+    mu_ex = virial.derivatives["A"].data
+    assert np.allclose(state.fields["A"].data, np.exp(mu - mu_ex - V), atol=1e-6)
+
+    # bulk density far from the wall
+    x = state.mesh.local.centers
+    assert np.allclose(state.fields["A"][x > 3.0], 0.2, atol=1e-6)
@@ -1,6 +1,8 @@
 import numpy as np
 import pytest
 
+import flyft
+
 
 def fex_py(eta, v):
     """Percus-Yevick free-energy density of hard spheres (compressibility route)"""
@@ -63,3 +65,123 @@ def test_compute(fmt, binary_state):
     assert fmt.value == pytest.approx(volume * fex_py(eta, v), abs=1e-3)
     assert np.allclose(fmt.derivatives["A"].data, muex_py(eta), atol=1e-3)
     assert np.allclose(fmt.derivatives["B"].data, muex_py(eta), atol=1e-3)
+
+
+def test_low_memory(fmt, binary_state):
+    assert not fmt.low_memory
+    fmt.low_memory = True
+    assert fmt.low_memory
+    assert fmt._self.low_memory
+
+    # sharing scratch storage should not change the result
+    state = binary_state
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 0.02 * (1 + 0.5 * np.cos(2 * np.pi * x / state.mesh.full.L))
+    state.fields["B"][:] = 0.01
+    fmt.diameters["A"] = 1.0
+    fmt.diameters["B"] = 0.5
+    fmt.compute(state)
+
+    fmt2 = flyft.functional.RosenfeldFMT()
+    fmt2.diameters = {"A": 1.0, "B": 0.5}
+    fmt2.compute(state)
+    assert fmt.value == pytest.approx(fmt2.value)
+    assert np.allclose(fmt.derivatives["A"].data, fmt2.derivatives["A"].data)
+    assert np.allclose(fmt.derivatives["B"].data, fmt2.derivatives["B"].data)
+
+
+def test_reflect_lower_edge(fmt):
+    # a reflecting lower boundary mirrors the first point past the edge region into the
+    # buffer, so the result must not depend on the previous evaluation
+    mesh = flyft.state.CartesianMesh(10.0, 100, ("reflect", "zero"), 1.0)
+    state = flyft.State(flyft.state.ParallelMesh(mesh), ("A",))
+    x = state.mesh.local.centers
+    fmt.diameters["A"] = 1.0
+
+    state.fields["A"][:] = 0.2 * (1 + 0.5 * np.cos(2 * np.pi * x / mesh.L))
+    fmt.compute(state)
+    value = fmt.value
+    derivative = fmt.derivatives["A"].data.copy()
+
+    state.fields["A"][:] = 0.2 * (1 + 0.1 * np.cos(2 * np.pi * x / mesh.L))
+    fmt.compute(state)
+
+    state.fields["A"][:] = 0.2 * (1 + 0.5 * np.cos(2 * np.pi * x / mesh.L))
+    fmt.compute(state)
+    assert fmt.value == pytest.approx(value)
+    assert np.allclose(fmt.derivatives["A"].data, derivative)
+
+
+def test_reflect_cosine_series(fmt):
+    # the cosine series on a reflecting mesh mirrors the density about the ends of the
+    # mesh, halfway between the first or last point and its image, so it matches the
+    # periodic calculation on a doubled domain where the density is mirrored the same
+    # way
+    L = 10.0
+    N = 100
+    mesh = flyft.state.CartesianMesh(L, N, "reflect", 1.0)
+    state = flyft.State(flyft.state.ParallelMesh(mesh), ("A", "B"))
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 0.2 * (1 + 0.4 * np.exp(-x) + 0.2 * np.cos(x))
+    state.fields["B"][:] = 0.3 * (1 + 0.4 * np.exp(-x) + 0.2 * np.cos(x))
+    fmt.diameters["A"] = 1.0
+    fmt.diameters["B"] = 0.5
+    fmt.compute(state)
+
+    mesh2 = flyft.state.CartesianMesh(2 * L, 2 * N, "periodic", 1.0)
+    state2 = flyft.State(flyft.state.ParallelMesh(mesh2), ("A", "B"))
+    for t in ("A", "B"):
+        state2.fields[t][:N] = state.fields[t]
+        state2.fields[t][N:] = state.fields[t][::-1]
+    fmt2 = flyft.functional.RosenfeldFMT()
+    fmt2.diameters = {"A": 1.0, "B": 0.5}
+    fmt2.compute(state2)
+
+    # the periodic transform is buffered and padded, so it samples the weights at
+    # different wavevectors and the results only agree to the accuracy of the mesh
+    assert 2 * fmt.value == pytest.approx(fmt2.value, rel=1e-6)
+    for t in ("A", "B"):
+        d = fmt.derivatives[t].data
+        d2 = fmt2.derivatives[t].data
+        assert np.allclose(d, d2[:N], rtol=0, atol=1e-4)
+        assert np.allclose(d, d2[N:][::-1], rtol=0, atol=1e-4)
+
+
+@pytest.mark.parametrize("low_memory", [False, True])
+def test_spherical_origin_quadrature(fmt, low_memory):
+    # the bins within R of the origin on a mesh that does not start from the origin
+    # are integrated by quadrature, which must agree with the mesh that does when the
+    # density is the same, including after the diameter changes and the quadrature is
+    # rebuilt
+    fmt.low_memory = low_memory
+    L = 10.0
+    N = 200
+    k = 6
+    mesh = flyft.state.SphericalMesh(L, N - k, "repeat", lower_bound=k * L / N)
+    state = flyft.State(flyft.state.ParallelMesh(mesh), ("A",))
+    mesh0 = flyft.state.SphericalMesh(L, N, "repeat")
+    state0 = flyft.State(flyft.state.ParallelMesh(mesh0), ("A",))
+
+    def density(r):
+        dr = np.maximum(r - 1.5, 0)
+        return 0.02 * (1 + 2 * dr**2 * np.exp(-dr))
+
+    state.fields["A"][:] = density(state.mesh.local.centers)
+    state0.fields["A"][:] = density(state0.mesh.local.centers)
+    for d in (1.0, 2.0):
+        fmt.diameters["A"] = d
+        fmt.compute(state)
+        fmt0 = flyft.functional.RosenfeldFMT()
+        fmt0.diameters["A"] = d
+        fmt0.compute(state0)
+        assert np.allclose(
+            fmt.derivatives["A"].data, fmt0.derivatives["A"].data[k:], rtol=1e-3, atol=0
+        )
+
+    # the weighted densities of a uniform density give the bulk chemical potential
+    state.fields["A"][:] = 0.1
+    for d in (1.0, 2.0):
+        fmt.diameters["A"] = d
+        fmt.compute(state)
+        eta = np.pi * d**3 * 0.1 / 6
+        assert np.allclose(fmt.derivatives["A"].data, muex_py(eta), rtol=1e-3, atol=0)
@@ -9,6 +9,16 @@ def spherical_mesh_grand():
     return flyft.state.SphericalMesh(10.0, 1000, "repeat")
 
 
+@pytest.fixture
+def cartesian_mesh_grand():
+    return flyft.state.CartesianMesh(10.0, 1000, "periodic", 1.0)
+
+
+@pytest.fixture
+def cartesian_state_grand(cartesian_mesh_grand):
+    return flyft.State(flyft.state.ParallelMesh(cartesian_mesh_grand), ("A",))
+
+
 @pytest.fixture
 def state_grand(spherical_mesh_grand):
     return flyft.State(flyft.state.ParallelMesh(spherical_mesh_grand), ("A",))
@@ -308,3 +318,117 @@ def test_binary_ideal(grand, ig, rpy, binary_state_grand):
     # Shifting bin centers to the lower bound of each of bin
     flags = lower_bounds < R - (ai + ak)
     assert np.allclose(rpy.fluxes["A"][flags], flux[flags], atol=1e-3)
+
+
+def test_cartesian_ideal(grand, ig, rpy, cartesian_state_grand):
+    state = cartesian_state_grand
+    ai = 0.5
+    L = state.mesh.full.L
+
+    ig.volumes["A"] = 1.0
+    grand.ideal = ig
+    rpy.diameters["A"] = 2 * ai
+    rpy.viscosity = 1.0
+
+    # uniform density has no flux
+    state.fields["A"][:] = 1.0
+    grand.constrain("A", state.mesh.full.volume(), grand.Constraint.N)
+    rpy.compute(grand, state)
+    assert np.allclose(rpy.fluxes["A"], 0.0)
+
+    r"""For a sinusoidal density \rho(x) = 1 + \sin(kx)/2, the ideal gas force
+    density is \rho'(x). The laterally averaged mobility for |z| < d = 2 a_i is
+
+    M(z) = -5 a_i^2 (d^2 - z^2) / (6 \eta d^3),
+
+    and its convolution with \rho' has the closed form
+
+    \int M(z) \rho'(x+z) dz
+        = -5 a_i^2 \rho'(x) 4 (\sin(kd) - kd \cos(kd)) / (6 \eta d^3 k^3)."""
+    k = 2 * np.pi / L
+    d = 2 * ai
+    x = state.mesh.local.centers
+    state.fields["A"][:] = 1.0 + 0.5 * np.sin(k * x)
+    rpy.compute(grand, state)
+
+    x = np.array([state.mesh.local.lower_bound(i) for i in range(len(x))])
+    rho = 1.0 + 0.5 * np.sin(k * x)
+    drho = 0.5 * k * np.cos(k * x)
+    bd = -1 / (6 * np.pi * ai) * drho
+    M = (
+        -5
+        * ai**2
+        * drho
+        * 4
+        * (np.sin(k * d) - k * d * np.cos(k * d))
+        / (6 * d**3 * k**3)
+    )
+    flux = bd - rho * M
+    assert np.allclose(rpy.fluxes["A"], flux, atol=1e-4)
+
+
+def test_cartesian_translation(grand, ig, rpy, cartesian_state_grand):
+    """The integration for the edges near the lower bound of a periodic mesh reaches a
+    full contact distance into the buffer, so shifting the density by a whole number of
+    bins should only shift the fluxes."""
+    state = cartesian_state_grand
+    virial = flyft.functional.VirialExpansion()
+    ai = 0.5
+    L = state.mesh.full.L
+    k = 2 * np.pi / L
+
+    ig.volumes["A"] = 1.0
+    virial.coefficients["A", "A"] = 2.0
+    grand.ideal = ig
+    grand.excess = virial
+    rpy.diameters["A"] = 2 * ai
+    rpy.viscosity = 1.0
+
+    x = state.mesh.local.centers
+    rho = 1.0 + 0.5 * np.sin(k * x) + 0.2 * np.cos(3 * k * x)
+    grand.constrain("A", state.mesh.full.volume(), grand.Constraint.N)
+    state.fields["A"][:] = rho
+    rpy.compute(grand, state)
+    flux = np.array(rpy.fluxes["A"], copy=True)
+
+    shift = len(x) // 4
+    state.fields["A"][:] = np.roll(rho, shift)
+    rpy.compute(grand, state)
+    assert np.allclose(rpy.fluxes["A"], np.roll(flux, shift), atol=1e-10)
+
+
+def test_cartesian_far_from_origin(grand, ig, rpy):
+    """The mobility integral should not lose precision for edges many diameters from the
+    lower bound of the mesh, so check it against a direct quadrature over each
+    window."""
+    mesh = flyft.state.CartesianMesh(1000.0, 20000, "periodic", 1.0)
+    state = flyft.State(flyft.state.ParallelMesh(mesh), ("A",))
+    ai = 0.5
+    d = 2 * ai
+    L = state.mesh.full.L
+    step = state.mesh.full.step
+
+    ig.volumes["A"] = 1.0
+    grand.ideal = ig
+    rpy.diameters["A"] = d
+    rpy.viscosity = 1.0
+
+    k = 2 * np.pi * 50 / L
+    x = state.mesh.local.centers
+    rho = 1.0 + 0.5 * np.sin(k * x)
+    state.fields["A"][:] = rho
+    grand.constrain("A", state.mesh.full.volume(), grand.Constraint.N)
+    rpy.compute(grand, state)
+
+    # quadrature of the kernel against the ideal gas force on the lower edges in the
+    # window
+    drho = (rho - np.roll(rho, 1)) / step
+    rho_edge = 0.5 * (rho + np.roll(rho, 1))
+    reach = int(round(d / step))
+    integral = np.zeros_like(rho)
+    for m in range(-reach, reach):
+        z = m * step
+        integral += (d**2 - z**2) * np.roll(drho, -m)
+    integral *= -(5 * ai**2) / (6 * d**3) * step
+    flux = -1 / (6 * np.pi * ai) * drho - rho_edge * integral
+    assert np.allclose(rpy.fluxes["A"], flux, rtol=0, atol=1e-10)
@@ -0,0 +1,18 @@
+#include "flyft/bogacki_shampine_integrator.h"
+
+namespace flyft
+    {
+
+BogackiShampineIntegrator::BogackiShampineIntegrator(double timestep)
+    : EmbeddedRungeKuttaIntegrator(timestep,
+                                   {{},
+                                    {1. / 2.},
+                                    {0., 3. / 4.},
+                                    {2. / 9., 1. / 3., 4. / 9.}},
+                                   {2. / 9., 1. / 3., 4. / 9., 0.},
+                                   {7. / 24., 1. / 4., 1. / 3., 1. / 8.},
+                                   {0., 1. / 2., 3. / 4., 1.})
+    {
+    }
+
+    } // namespace flyft
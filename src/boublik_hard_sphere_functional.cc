@@ -1,5 +1,7 @@
 #include "flyft/boublik_hard_sphere_functional.h"
 
+#include "flyft/indexed_type_map.h"
+
 #include <algorithm>
 #include <cmath>
 
@@ -12,10 +14,10 @@ BoublikHardSphereFunctional::BoublikHardSphereFunctional()
     }
 
 static void computeFunctionalMixture(int idx,
-                                     const std::vector<Field::View>& derivs,
+                                     const IndexedTypeMap<Field::View>& derivs,
                                      double& value,
-                                     const std::vector<Field::ConstantView>& fields,
-                                     const std::vector<double>& diams,
+                                     const IndexedTypeMap<Field::ConstantView>& fields,
+                                     const IndexedTypeMap<double>& diams,
                                      const Mesh* mesh,
                                      bool compute_value)
     {
@@ -23,10 +25,10 @@ static void computeFunctionalMixture(int idx,
 
     // compute scaled particle variables
     double xi[4] = {0, 0, 0, 0};
-    for (size_t i = 0; i < num_types; ++i)
+    for (int i = 0; i < num_types; ++i)
         {
-        const auto rhoi = fields[i](idx);
-        const auto di = diams[i];
+        const auto rhoi = fields(i)(idx);
+        const auto di = diams(i);
         double xim_i = rhoi * M_PI / 6.;
         for (int m = 0; m < 4; ++m)
             {
@@ -61,10 +63,10 @@ static void computeFunctionalMixture(int idx,
                - xi2_3 / (xi3_2 * vf_2) + 2. * xi2_3 / (xi[3] * vf_3));
 
         // compute chemical potential
-        for (size_t i = 0; i < num_types; ++i)
+        for (int i = 0; i < num_types; ++i)
             {
-            const auto di = diams[i];
-            derivs[i](idx) = -logvf + di * (c1 + di * (c2 + di * c3));
+            const auto di = diams(i);
+            derivs(i)(idx) = -logvf + di * (c1 + di * (c2 + di * c3));
             }
 
         // compute free energy
@@ -83,9 +85,9 @@ static void computeFunctionalMixture(int idx,
         }
     else
         {
-        for (size_t i = 0; i < num_types; ++i)
+        for (int i = 0; i < num_types; ++i)
             {
-            derivs[i](idx) = 0.;
+            derivs(i)(idx) = 0.;
             }
         energy = 0.;
         }
@@ -93,15 +95,15 @@ static void computeFunctionalMixture(int idx,
     }
 
 static void computeFunctionalPure(int idx,
-                                  const std::vector<Field::View>& derivs,
+                                  const IndexedTypeMap<Field::View>& derivs,
                                   double& value,
-                                  const std::vector<Field::ConstantView>& fields,
-                                  const std::vector<double>& diams,
+                                  const IndexedTypeMap<Field::ConstantView>& fields,
+                                  const IndexedTypeMap<double>& diams,
                                   const Mesh* mesh,
                                   bool compute_value)
     {
-    const auto rho = fields[0](idx);
-    const auto d = diams[0];
+    const auto rho = fields(0)(idx);
+    const auto d = diams(0);
     const auto eta = M_PI * rho * d * d * d / 6.;
 
     // the excess terms will only be nonzero if nonzero density and diameter
@@ -114,7 +116,7 @@ static void computeFunctionalPure(int idx,
         const auto vf_3 = vf_2 * vf;
 
         // compute chemical potential
-        derivs[0](idx) = eta * (8. + eta * (-9. + eta * 3.)) / vf_3;
+        derivs(0)(idx) = eta * (8. + eta * (-9. + eta * 3.)) / vf_3;
 
         // compute free energy
         if (compute_value)
@@ -128,7 +130,7 @@ static void computeFunctionalPure(int idx,
         }
     else
         {
-        derivs[0](idx) = 0.;
+        derivs(0)(idx) = 0.;
         energy = 0.;
         }
     value += energy;
@@ -136,22 +138,21 @@ static void computeFunctionalPure(int idx,
 
 void BoublikHardSphereFunctional::_compute(std::shared_ptr<State> state, bool compute_value)
     {
-    auto types = state->getTypes();
+    const auto& types = state->getTypes();
     const auto mesh = state->getMesh()->local().get();
 
     // process maps into indexed arrays for quicker access inside loop
-    const auto num_types = types.size();
-    std::vector<Field::ConstantView> fields(num_types);
-    std::vector<Field::View> derivs(num_types);
+    const int num_types = static_cast<int>(types.size());
+    IndexedTypeMap<Field::ConstantView> fields(num_types);
+    IndexedTypeMap<Field::View> derivs(num_types);
     std::vector<int> deriv_buffers(num_types);
-    std::vector<double> diams(num_types);
-    for (size_t i = 0; i < num_types; ++i)
+    const IndexedTypeMap<double> diams(types, diameters_);
+    for (int i = 0; i < num_types; ++i)
         {
         const auto type_i = types[i];
         fields[i] = state->getField(type_i)->const_view();
         derivs[i] = derivatives_(type_i)->view();
         deriv_buffers[i] = derivatives_(type_i)->buffer_shape();
-        diams[i] = diameters_(type_i);
         }
 
     // reset energy to zero before accumulating
@@ -161,8 +162,10 @@ void BoublikHardSphereFunctional::_compute(std::shared_ptr<State> state, bool co
     // General Boublik functional for mixture, otherwise use simpler pure substance one
     auto functional = (num_types > 1) ? computeFunctionalMixture : computeFunctionalPure;
 
-    // compute edges of all derivatives first
-    for (int idx = 0; idx < max_deriv_buffer; ++idx)
+    // compute edges of all derivatives first, including the point that a reflecting lower
+    // boundary mirrors into the buffer
+    const int lower_edge = std::min(max_deriv_buffer + 1, mesh->shape() - max_deriv_buffer);
+    for (int idx = 0; idx < lower_edge; ++idx)
         {
         functional(idx, derivs, value_, fields, diams, mesh, compute_value);
         }
@@ -174,11 +177,11 @@ void BoublikHardSphereFunctional::_compute(std::shared_ptr<State> state, bool co
 
 // compute on interior points
 #ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(num_types, mesh) \
-    shared(fields, derivs, diams, compute_value, max_deriv_buffer, functional)        \
+#pragma omp parallel for schedule(static) default(none) firstprivate(num_types, mesh, lower_edge) \
+    shared(fields, derivs, diams, compute_value, max_deriv_buffer, functional)                    \
     reduction(+ : value_)
 #endif
-    for (int idx = max_deriv_buffer; idx < mesh->shape() - max_deriv_buffer; ++idx)
+    for (int idx = lower_edge; idx < mesh->shape() - max_deriv_buffer; ++idx)
         {
         functional(idx, derivs, value_, fields, diams, mesh, compute_value);
         }
@@ -1,14 +1,24 @@
 #include "flyft/brownian_diffusive_flux.h"
 
+#include "flyft/mesh_dispatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#ifdef FLYFT_OPENMP
+#include <omp.h>
+#endif
+
 namespace flyft
     {
 
+template<class MeshType>
 static double calculateFlux(int idx,
                             double D,
                             const Field::ConstantView& rho,
                             const Field::ConstantView& mu_ex,
                             const Field::ConstantView& V,
-                            const Mesh* mesh)
+                            const MeshType* mesh)
     {
     // handle infinite external potentials carefully, as there should be no flux in those directions
     double flux;
@@ -58,57 +68,148 @@ static double calculateFlux(int idx,
     return flux;
     }
 
-void BrownianDiffusiveFlux::compute(std::shared_ptr<GrandPotential> grand,
-                                    std::shared_ptr<State> state)
+//! Flux on edges [first, last)
+template<class MeshType>
+static void calculateInteriorFlux(int first,
+                                  int last,
+                                  double D,
+                                  const Field::ConstantView& rho,
+                                  const Field::ConstantView& mu_ex,
+                                  const Field::ConstantView& V,
+                                  const Field::View& flux,
+                                  const MeshType* mesh)
     {
-    setup(grand, state);
-
-    // evaluate functionals separately to handle ideal as special case
-    auto excess = grand->getExcessFunctional();
-    auto external = grand->getExternalPotential();
-    if (excess)
-        {
-        excess->compute(state, false);
-        }
-    if (external)
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(first, last, D, mesh) \
+    shared(rho, mu_ex, V, flux)
+#endif
+    for (int idx = first; idx < last; ++idx)
         {
-        external->compute(state, false);
+        flux(idx) = calculateFlux(idx, D, rho, mu_ex, V, mesh);
         }
-    // sync fields as a precaution, but this will already likely have been done by functionals
-    state->syncFields();
+    }
 
-    // compute fluxes on the left edge of the volumes (exclude the first point)
-    const auto mesh = state->getMesh()->local().get();
-    for (const auto& t : state->getTypes())
+//! Explicit update of the densities on points [first, last) with fluxes computed on the fly
+/*!
+ * The flux on each edge is computed from the densities before they are updated. Each thread
+ * walks its own chunk in order, so only the flux on the first edge of each chunk, which reads a
+ * density owned by another chunk, is computed before the threads synchronize. The flux on edge
+ * last must be supplied, since that density may not be updated until after this function.
+ */
+template<class MeshType>
+static void updateInteriorDensity(int first,
+                                  int last,
+                                  double flux_last,
+                                  double timestep,
+                                  double D,
+                                  const Field::ConstantView& rho,
+                                  const Field::ConstantView& mu_ex,
+                                  const Field::ConstantView& V,
+                                  const Field::View& rho_new,
+                                  const MeshType* mesh)
+    {
+    const double* areas = mesh->areas();
+    const double* inv_volumes = mesh->inverse_volumes();
+#ifdef FLYFT_OPENMP
+    std::vector<double> flux_starts(omp_get_max_threads());
+#else
+    std::vector<double> flux_starts(1);
+#endif
+
+#ifdef FLYFT_OPENMP
+#pragma omp parallel default(none) \
+    firstprivate(first, last, flux_last, timestep, D, mesh, areas, inv_volumes) \
+    shared(rho, mu_ex, V, rho_new, flux_starts)
+#endif
         {
-        const auto D = diffusivities_(t);
-        auto rho = state->getField(t)->const_view();
-        auto mu_ex = (excess) ? excess->getDerivative(t)->const_view() : Field::ConstantView();
-        auto V = (external) ? external->getDerivative(t)->const_view() : Field::ConstantView();
-        auto flux = fluxes_(t)->view();
-
-        // compute flux on edges and start sending
-        int flux_buffer = fluxes_(t)->buffer_shape();
-        for (int idx = 0; idx < flux_buffer; ++idx)
-            {
-            flux(idx) = calculateFlux(idx, D, rho, mu_ex, V, mesh);
-            }
-        for (int idx = mesh->shape() - flux_buffer; idx < mesh->shape(); ++idx)
-            {
-            flux(idx) = calculateFlux(idx, D, rho, mu_ex, V, mesh);
-            }
-        state->getMesh()->startSync(fluxes_(t));
+#ifdef FLYFT_OPENMP
+        const int thread = omp_get_thread_num();
+        const int num_threads = omp_get_num_threads();
+#else
+        const int thread = 0;
+        const int num_threads = 1;
+#endif
+        const int chunk = (last - first + num_threads - 1) / num_threads;
+        const int chunk_first = std::min(first + thread * chunk, last);
+        const int chunk_last = std::min(chunk_first + chunk, last);
 
-// compute flux on interior points
+        flux_starts[thread] = calculateFlux(chunk_first, D, rho, mu_ex, V, mesh);
 #ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(D, mesh) \
-    shared(rho, mu_ex, V, flux, flux_buffer)
+#pragma omp barrier
 #endif
-        for (int idx = flux_buffer; idx < mesh->shape() - flux_buffer; ++idx)
+
+        const double flux_end = (thread + 1 < num_threads) ? flux_starts[thread + 1] : flux_last;
+        double j_lo = flux_starts[thread];
+        for (int idx = chunk_first; idx < chunk_last; ++idx)
             {
-            flux(idx) = calculateFlux(idx, D, rho, mu_ex, V, mesh);
+            const double j_hi = (idx + 1 < chunk_last)
+                                    ? calculateFlux(idx + 1, D, rho, mu_ex, V, mesh)
+                                    : flux_end;
+            const double divergence = areas[idx] * j_lo - areas[idx + 1] * j_hi;
+            rho_new(idx) = rho(idx) + timestep * (divergence * inv_volumes[idx]);
+            j_lo = j_hi;
             }
         }
+    }
+
+BrownianDiffusiveFlux::BrownianDiffusiveFlux()
+    {
+    compute_depends_.add(&diffusivities_);
+    }
+
+void BrownianDiffusiveFlux::_compute(std::shared_ptr<GrandPotential> grand,
+                                     std::shared_ptr<State> state)
+    {
+    // functionals have already been evaluated and synced by setup
+    auto excess = grand->getExcessFunctional();
+    auto external = grand->getExternalPotential();
+
+    // compute fluxes on the left edge of the volumes (exclude the first point), with the kernel
+    // specialized to the mesh geometry
+    dispatchMesh(state->getMesh()->local().get(),
+                 [&](auto mesh)
+                 {
+                     for (const auto& t : state->getTypes())
+                         {
+                         const auto D = diffusivities_(t);
+                         auto rho = state->getField(t)->const_view();
+                         auto mu_ex = (excess) ? excess->getDerivative(t)->const_view()
+                                               : Field::ConstantView();
+                         auto V = (external) ? external->getDerivative(t)->const_view()
+                                             : Field::ConstantView();
+                         auto flux = fluxes_(t)->view();
+
+                         // compute flux on edges and start sending, including the edge that a
+                         // reflecting lower boundary mirrors into the buffer
+                         const int flux_buffer = fluxes_(t)->buffer_shape();
+                         const int lower_edge
+                             = std::min(flux_buffer + 1, mesh->shape() - flux_buffer);
+                         for (int idx = 0; idx < lower_edge; ++idx)
+                             {
+                             flux(idx) = calculateFlux(idx, D, rho, mu_ex, V, mesh);
+                             }
+                         for (int idx = mesh->shape() - flux_buffer; idx < mesh->shape(); ++idx)
+                             {
+                             flux(idx) = calculateFlux(idx, D, rho, mu_ex, V, mesh);
+                             }
+                         state->getMesh()->startSync(fluxes_(t));
+
+                         // compute flux on interior points, which is zero on edges touching a
+                         // point outside the active range of the external potential
+                         const int interior_last = mesh->shape() - flux_buffer;
+                         int first = lower_edge;
+                         int last = interior_last;
+                         if (external)
+                             {
+                             const auto active = external->getActiveRange(t);
+                             first = std::min(std::max(first, active.first), interior_last);
+                             last = std::max(std::min(last, active.second), first);
+                             }
+                         std::fill(flux.begin() + lower_edge, flux.begin() + first, 0.);
+                         std::fill(flux.begin() + last, flux.begin() + interior_last, 0.);
+                         calculateInteriorFlux(first, last, D, rho, mu_ex, V, flux, mesh);
+                         }
+                 });
 
     // finalize all flux communication
     for (const auto& t : state->getTypes())
@@ -117,6 +218,106 @@ void BrownianDiffusiveFlux::compute(std::shared_ptr<GrandPotential> grand,
         }
     }
 
+void BrownianDiffusiveFlux::applyExplicitUpdate(std::shared_ptr<GrandPotential> grand,
+                                                std::shared_ptr<State> state,
+                                                double timestep)
+    {
+    // use the stored fluxes if they are already valid, or if the mesh is too small to have an
+    // interior that does not overlap the edges
+    const auto local_mesh = state->getMesh()->local().get();
+    bool fused = setup(grand, state);
+    for (const auto& t : state->getTypes())
+        {
+        const int flux_buffer = fluxes_(t)->buffer_shape();
+        if (flux_buffer < 1 || local_mesh->shape() < 2 * flux_buffer + 1)
+            {
+            fused = false;
+            }
+        }
+    if (!fused)
+        {
+        Flux::applyExplicitUpdate(grand, state, timestep);
+        return;
+        }
+
+    // only the fluxes on the edges are computed and exchanged, then the interior is updated
+    // directly from fluxes computed on the fly. the edges are updated last, once the fluxes
+    // from the neighbors have arrived.
+    auto excess = grand->getExcessFunctional();
+    auto external = grand->getExternalPotential();
+    dispatchMesh(
+        local_mesh,
+        [&](auto mesh)
+        {
+            const int shape = mesh->shape();
+            for (const auto& t : state->getTypes())
+                {
+                const auto D = diffusivities_(t);
+                auto rho = state->getField(t)->const_view();
+                auto mu_ex = (excess) ? excess->getDerivative(t)->const_view()
+                                      : Field::ConstantView();
+                auto V = (external) ? external->getDerivative(t)->const_view()
+                                    : Field::ConstantView();
+                auto flux = fluxes_(t)->view();
+
+                // compute flux on edges, including the first interior edge, and start sending
+                const int flux_buffer = fluxes_(t)->buffer_shape();
+                for (int idx = 0; idx <= flux_buffer; ++idx)
+                    {
+                    flux(idx) = calculateFlux(idx, D, rho, mu_ex, V, mesh);
+                    }
+                for (int idx = shape - flux_buffer; idx < shape; ++idx)
+                    {
+                    flux(idx) = calculateFlux(idx, D, rho, mu_ex, V, mesh);
+                    }
+                state->getMesh()->startSync(fluxes_(t));
+
+                // update interior points, skipping points outside the active range of the
+                // external potential because there is no flux through any of their edges
+                const int interior_last = shape - flux_buffer;
+                int first = flux_buffer;
+                int last = interior_last;
+                if (external)
+                    {
+                    const auto active = external->getActiveRange(t);
+                    first = std::min(std::max(first, active.first), interior_last);
+                    last = std::max(std::min(last, active.second), first);
+                    }
+                updateInteriorDensity(first,
+                                      last,
+                                      (last < interior_last) ? 0. : flux(interior_last),
+                                      timestep,
+                                      D,
+                                      rho,
+                                      mu_ex,
+                                      V,
+                                      state->getField(t)->view(),
+                                      mesh);
+                }
+
+            // finalize flux communication and update the edges
+            for (const auto& t : state->getTypes())
+                {
+                state->getMesh()->endSync(fluxes_(t));
+                auto rho = state->getField(t)->view();
+                auto j = fluxes_(t)->const_view();
+                const double* inv_volumes = mesh->inverse_volumes();
+                const int flux_buffer = fluxes_(t)->buffer_shape();
+                for (int idx = 0; idx < flux_buffer; ++idx)
+                    {
+                    rho(idx) += timestep * (mesh->integrateSurface(idx, j) * inv_volumes[idx]);
+                    }
+                for (int idx = shape - flux_buffer; idx < shape; ++idx)
+                    {
+                    rho(idx) += timestep * (mesh->integrateSurface(idx, j) * inv_volumes[idx]);
+                    }
+                }
+        });
+
+    // the interior fluxes were not stored, so the flux fields are not valid for this state
+    compute_token_ = Token();
+    }
+
 TypeMap<double>& BrownianDiffusiveFlux::getDiffusivities()
     {
     return diffusivities_;
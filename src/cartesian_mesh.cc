@@ -1,4 +1,5 @@
 #include "flyft/cartesian_mesh.h"
+#include "flyft/fourier_transform.h"
 
 namespace flyft
     {
@@ -11,30 +12,17 @@ CartesianMesh::CartesianMesh(double lower_bound,
                              double area)
     : Mesh(lower_bound, upper_bound, shape, lower_bc, upper_bc), area_(area)
     {
+    setupGeometry();
     }
 
-std::shared_ptr<Mesh> CartesianMesh::clone() const
-    {
-    return std::make_shared<CartesianMesh>(*this);
-    }
-
-double CartesianMesh::area(int /*i*/) const
-    {
-    return area_;
-    }
-
-double CartesianMesh::volume() const
+int CartesianMesh::fastShape(int shape)
     {
-    return area_ * L();
+    return FourierTransform::fastSize(shape);
     }
 
-double CartesianMesh::volume(int /*i*/) const
+std::shared_ptr<Mesh> CartesianMesh::clone() const
     {
-    return area_ * step_;
+    return std::make_shared<CartesianMesh>(*this);
     }
 
-double CartesianMesh::gradient(int /*i*/, double f_lo, double f_hi) const
-    {
-    return (f_hi - f_lo) / step_;
-    }
     } // namespace flyft
@@ -5,10 +5,18 @@
 namespace flyft
     {
 
-void CompositeFlux::compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state)
+bool CompositeFlux::setup(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state)
     {
-    setup(grand, state);
+    for (const auto& o : objects_)
+        {
+        o->compute(grand, state);
+        }
+    return Flux::setup(grand, state);
+    }
 
+void CompositeFlux::_compute(std::shared_ptr<GrandPotential> /*grand*/,
+                             std::shared_ptr<State> state)
+    {
     // initialize to zeros
     for (const auto& t : state->getTypes())
         {
@@ -19,7 +27,6 @@ void CompositeFlux::compute(std::shared_ptr<GrandPotential> grand, std::shared_p
     // combine
     for (const auto& o : objects_)
         {
-        o->compute(grand, state);
         for (const auto& t : state->getTypes())
             {
             auto j = fluxes_(t)->full_view();
@@ -38,4 +45,36 @@ void CompositeFlux::requestFluxBuffer(const std::string& type, int buffer_reques
         }
     }
 
+bool CompositeFlux::addObject(std::shared_ptr<Flux> object)
+    {
+    bool added = CompositeMixin<Flux>::addObject(object);
+    if (added)
+        {
+        compute_depends_.add(object.get());
+        }
+    return added;
+    }
+
+bool CompositeFlux::removeObject(std::shared_ptr<Flux> object)
+    {
+    bool removed = CompositeMixin<Flux>::removeObject(object);
+    if (removed)
+        {
+        compute_depends_.remove(object->id());
+        }
+    return removed;
+    }
+
+void CompositeFlux::clearObjects()
+    {
+    if (objects_.size() > 0)
+        {
+        for (const auto& o : objects_)
+            {
+            compute_depends_.remove(o->id());
+            }
+        CompositeMixin<Flux>::clearObjects();
+        }
+    }
+
     } // namespace flyft
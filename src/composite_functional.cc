@@ -1,6 +1,9 @@
 #include "flyft/composite_functional.h"
 
+#include "flyft/field_expression.h"
+
 #include <algorithm>
+#include <vector>
 
 namespace flyft
     {
@@ -18,31 +21,26 @@ bool CompositeFunctional::setup(std::shared_ptr<State> state, bool compute_value
 
 void CompositeFunctional::_compute(std::shared_ptr<State> state, bool compute_value)
     {
-    // initialize to zeros
+    // accumulate values
     value_ = 0.0;
-    for (const auto& t : state->getTypes())
+    if (compute_value)
         {
-        auto d = derivatives_(t)->full_view();
-        std::fill(d.begin(), d.end(), 0.);
-        }
-
-    // combine
-    for (const auto& f : objects_)
-        {
-        // acumulate values
-        if (compute_value)
+        for (const auto& f : objects_)
             {
-            const auto v = f->getValue();
-            value_ += v;
+            value_ += f->getValue();
             }
+        }
 
-        // accumulate derivatives
-        for (const auto& t : state->getTypes())
+    // accumulate derivatives in one pass over each type
+    for (const auto& t : state->getTypes())
+        {
+        std::vector<Field::ConstantView> terms;
+        terms.reserve(objects_.size());
+        for (const auto& f : objects_)
             {
-            auto d = derivatives_(t)->full_view();
-            auto df = f->getDerivative(t)->const_full_view();
-            std::transform(d.begin(), d.end(), df.begin(), d.begin(), std::plus<>());
+            terms.push_back(f->getDerivative(t)->const_full_view());
             }
+        assign(derivatives_(t)->full_view(), sum(terms));
         }
     }
 
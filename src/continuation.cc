@@ -0,0 +1,185 @@
+#include "flyft/continuation.h"
+
+#include "flyft/field_expression.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace flyft
+    {
+
+Continuation::Continuation(std::shared_ptr<Solver> solver, Predictor predictor)
+    : predictor_(predictor), grand_id_(0), state_id_(0)
+    {
+    setSolver(solver);
+    }
+
+bool Continuation::solve(std::shared_ptr<GrandPotential> grand,
+                         std::shared_ptr<State> state,
+                         double value)
+    {
+    if (!control_type_.empty())
+        {
+        // throws if the control type is not in the state
+        state->getTypeIndex(control_type_);
+        }
+
+    // previous solutions only apply to the same system
+    if (grand->id() != grand_id_ || state->id() != state_id_)
+        {
+        reset();
+        grand_id_ = grand->id();
+        state_id_ = state->id();
+        }
+
+    predict(state, value);
+    if (control_type_.empty())
+        {
+        state->setTime(value);
+        }
+    else
+        {
+        grand->getConstraints()[control_type_] = value;
+        }
+
+    const bool converged = solver_->solve(grand, state);
+    if (converged)
+        {
+        store(state, value);
+        }
+    return converged;
+    }
+
+void Continuation::reset()
+    {
+    solutions_.clear();
+    }
+
+std::shared_ptr<Solver> Continuation::getSolver()
+    {
+    return solver_;
+    }
+
+void Continuation::setSolver(std::shared_ptr<Solver> solver)
+    {
+    if (!solver)
+        {
+        throw std::invalid_argument("Continuation needs a solver");
+        }
+    solver_ = solver;
+    }
+
+Continuation::Predictor Continuation::getPredictor() const
+    {
+    return predictor_;
+    }
+
+void Continuation::setPredictor(Predictor predictor)
+    {
+    predictor_ = predictor;
+    }
+
+std::string Continuation::getControlType() const
+    {
+    return control_type_;
+    }
+
+void Continuation::setControlType(const std::string& type)
+    {
+    if (type != control_type_)
+        {
+        control_type_ = type;
+        reset();
+        }
+    }
+
+int Continuation::getNumSolutions() const
+    {
+    return static_cast<int>(solutions_.size());
+    }
+
+void Continuation::predict(std::shared_ptr<State> state, double value) const
+    {
+    int order = 0;
+    if (predictor_ == Predictor::secant)
+        {
+        order = 1;
+        }
+    else if (predictor_ == Predictor::quadratic)
+        {
+        order = 2;
+        }
+    const int num_points = std::min(order + 1, getNumSolutions());
+    if (num_points < 2)
+        {
+        // without enough solutions, start from the current densities
+        return;
+        }
+
+    // Lagrange weights of the most recent solutions at the new value
+    const int first = getNumSolutions() - num_points;
+    std::vector<double> weights(num_points, 1.0);
+    for (int j = 0; j < num_points; ++j)
+        {
+        const double x_j = solutions_[first + j].value;
+        for (int m = 0; m < num_points; ++m)
+            {
+            if (m != j)
+                {
+                const double x_m = solutions_[first + m].value;
+                weights[j] *= (value - x_m) / (x_j - x_m);
+                }
+            }
+        }
+
+    const auto mesh = state->getMesh()->local().get();
+    for (const auto& t : state->getTypes())
+        {
+        auto rho = state->getField(t)->view();
+        assign(rho, weights[0] * solutions_[first].fields(t)->const_view());
+        for (int j = 1; j < num_points; ++j)
+            {
+            assign(rho, rho + weights[j] * solutions_[first + j].fields(t)->const_view());
+            }
+
+        // extrapolation can overshoot, but densities are never negative
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(mesh) shared(rho)
+#endif
+        for (int idx = 0; idx < mesh->shape(); ++idx)
+            {
+            if (rho(idx) < 0)
+                {
+                rho(idx) = 0.;
+                }
+            }
+        }
+    }
+
+void Continuation::store(std::shared_ptr<State> state, double value)
+    {
+    // repeated values would make the extrapolation singular, so replace them
+    solutions_.erase(std::remove_if(solutions_.begin(),
+                                    solutions_.end(),
+                                    [value](const Solution& s) { return s.value == value; }),
+                     solutions_.end());
+
+    // reuse the oldest fields once enough solutions are kept for the highest order predictor
+    Solution solution;
+    if (solutions_.size() == 3)
+        {
+        solution = std::move(solutions_.front());
+        solutions_.pop_front();
+        }
+    solution.value = value;
+    state->matchFields(solution.fields);
+    for (const auto& t : state->getTypes())
+        {
+        auto rho = state->getField(t)->const_full_view();
+        std::copy(rho.begin(), rho.end(), solution.fields[t]->full_view().begin());
+        }
+    solutions_.push_back(std::move(solution));
+    }
+
+    } // namespace flyft
@@ -1,6 +1,8 @@
 #include "flyft/crank_nicolson_integrator.h"
 
-#include <cmath>
+#include "flyft/field_expression.h"
+
+#include <algorithm>
 
 namespace flyft
     {
@@ -9,18 +11,8 @@ CrankNicolsonIntegrator::CrankNicolsonIntegrator(double timestep,
                                                  double mix_param,
                                                  int max_iterations,
                                                  double tolerance)
-    : Integrator(timestep), FixedPointAlgorithmMixin(mix_param, max_iterations, tolerance)
-    {
-    }
-
-bool CrankNicolsonIntegrator::advance(std::shared_ptr<Flux> flux,
-                                      std::shared_ptr<GrandPotential> grand,
-                                      std::shared_ptr<State> state,
-                                      double time)
+    : ImplicitIntegrator(timestep, mix_param, max_iterations, tolerance)
     {
-    state->matchFields(last_fields_);
-    state->matchFields(last_rates_);
-    return Integrator::advance(flux, grand, state, time);
     }
 
 void CrankNicolsonIntegrator::step(std::shared_ptr<Flux> flux,
@@ -28,71 +20,39 @@ void CrankNicolsonIntegrator::step(std::shared_ptr<Flux> flux,
                                    std::shared_ptr<State> state,
                                    double timestep)
     {
-    // evaluate initial fluxes at the **current** timestep
+    stepInto(flux, grand, state, state, timestep);
+    }
+
+void CrankNicolsonIntegrator::stepInto(std::shared_ptr<Flux> flux,
+                                       std::shared_ptr<GrandPotential> grand,
+                                       std::shared_ptr<State> state,
+                                       std::shared_ptr<State> next_state,
+                                       double timestep)
+    {
+    // evaluate initial fluxes at the **current** timestep, and take half an explicit step
     const auto mesh = state->getMesh()->local().get();
     flux->compute(grand, state);
     for (const auto& t : state->getTypes())
         {
         auto rho = state->getField(t)->const_view();
         auto j = flux->getFlux(t)->const_view();
-        auto last_rho = last_fields_(t)->view();
-        auto last_rate = last_rates_(t)->view();
-
-#ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(mesh) \
-    shared(rho, j, last_rho, last_rate)
-#endif
-        for (int idx = 0; idx < mesh->shape(); ++idx)
-            {
-            last_rho(idx) = rho(idx);
-            last_rate(idx) = mesh->integrateSurface(idx, j) / mesh->volume(idx);
-            }
+        assign(explicit_fields_(t)->view(),
+               rho + 0.5 * timestep * (integrateSurface(mesh, j) * inverseVolume(mesh)));
         }
 
-    // advance time of state to *next* point
-    state->advanceTime(timestep);
-
-    // solve nonlinear equation for **next** timestep by fixed-point iteration
-    const auto alpha = mix_param_;
-    const auto tol = tolerance_;
-    bool converged = false;
-    for (int iter = 0; iter < max_iterations_ && !converged; ++iter)
+    // densities at the **current** timestep are the initial guess for the next state
+    if (next_state != state)
         {
-        // propose converged, and invalidate if any change is too big
-        converged = true;
-
-        // get flux of the new state
-        flux->compute(grand, state);
-
-        // apply update
         for (const auto& t : state->getTypes())
             {
-            auto last_rho = last_fields_(t)->const_view();
-            auto last_rate = last_rates_(t)->const_view();
-            auto next_rho = state->getField(t)->view();
-            auto next_j = flux->getFlux(t)->const_view();
-
-#ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(timestep, mesh, alpha, tol) \
-    shared(next_rho, next_j, last_rho, last_rate, converged)
-#endif
-            for (int idx = 0; idx < mesh->shape(); ++idx)
-                {
-                const double next_rate = mesh->integrateSurface(idx, next_j) / mesh->volume(idx);
-                const double try_rho
-                    = last_rho(idx) + 0.5 * timestep * (last_rate(idx) + next_rate);
-                const double drho = alpha * (try_rho - next_rho(idx));
-                next_rho(idx) += drho;
-                if (drho > tol)
-                    {
-                    converged = false;
-                    }
-                }
+            auto f = state->getField(t)->const_view();
+            std::copy(f.begin(), f.end(), next_state->getField(t)->view().begin());
             }
-
-        converged = state->getCommunicator()->all(converged);
         }
-    if (!converged)
+    next_state->setTime(state->getTime() + timestep);
+
+    // solve nonlinear equation for **next** timestep with the other half implicit
+    if (!solve(flux, grand, next_state, explicit_fields_, 0.5 * timestep))
         {
         // TODO: Decide how to handle failed convergence... warning, error?
         }
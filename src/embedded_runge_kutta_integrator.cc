@@ -0,0 +1,302 @@
+#include "flyft/embedded_runge_kutta_integrator.h"
+
+#include "flyft/field_expression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace flyft
+    {
+
+//! Collect the nonzero weights of a stage combination and the rates they multiply
+static void gatherRates(const std::vector<double>& weights,
+                        const std::vector<TypeMap<std::shared_ptr<Field>>>& rates,
+                        const std::string& type,
+                        std::vector<double>& used_weights,
+                        std::vector<Field::ConstantView>& used_rates)
+    {
+    used_weights.clear();
+    used_rates.clear();
+    for (size_t k = 0; k < weights.size(); ++k)
+        {
+        if (weights[k] != 0.)
+            {
+            used_weights.push_back(weights[k]);
+            used_rates.push_back(rates[k](type)->const_view());
+            }
+        }
+    }
+
+//! Set out = rho + timestep * sum_k weights[k] * rates[k]
+static void combineRates(const Field::View& out,
+                         const Field::ConstantView& rho,
+                         double timestep,
+                         const std::vector<double>& weights,
+                         const std::vector<Field::ConstantView>& rates)
+    {
+    const int shape = out.size();
+    const int num_rates = static_cast<int>(rates.size());
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(shape, num_rates, timestep) \
+    shared(out, rho, weights, rates)
+#endif
+    for (int idx = 0; idx < shape; ++idx)
+        {
+        double rate = 0.;
+        for (int k = 0; k < num_rates; ++k)
+            {
+            rate += weights[k] * rates[k](idx);
+            }
+        out(idx) = rho(idx) + timestep * rate;
+        }
+    }
+
+//! Maximum of |timestep * sum_k weights[k] * rates[k]|
+static double maxCombinedRate(double timestep,
+                              const std::vector<double>& weights,
+                              const std::vector<Field::ConstantView>& rates,
+                              int shape)
+    {
+    const int num_rates = static_cast<int>(rates.size());
+    double max_err = 0.;
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(shape, num_rates, timestep) \
+    shared(weights, rates) reduction(max : max_err)
+#endif
+    for (int idx = 0; idx < shape; ++idx)
+        {
+        double rate = 0.;
+        for (int k = 0; k < num_rates; ++k)
+            {
+            rate += weights[k] * rates[k](idx);
+            }
+        const double err = std::abs(timestep * rate);
+        if (err > max_err)
+            {
+            max_err = err;
+            }
+        }
+    return max_err;
+    }
+
+EmbeddedRungeKuttaIntegrator::EmbeddedRungeKuttaIntegrator(
+    double timestep,
+    const std::vector<std::vector<double>>& a,
+    const std::vector<double>& b,
+    const std::vector<double>& b_hat,
+    const std::vector<double>& c)
+    : Integrator(timestep), a_(a), b_(b), c_(c), has_first_rate_(false)
+    {
+    const size_t num_stages = c_.size();
+    if (a_.size() != num_stages || b_.size() != num_stages || b_hat.size() != num_stages)
+        {
+        throw std::invalid_argument("Butcher tableau must have the same number of stages");
+        }
+
+    b_err_.resize(num_stages);
+    for (size_t k = 0; k < num_stages; ++k)
+        {
+        b_err_[k] = b_[k] - b_hat[k];
+        }
+
+    // the last stage is the solution if it uses the solution weights
+    fsal_ = (c_.back() == 1. && b_.back() == 0.);
+    for (size_t k = 0; k < num_stages - 1 && fsal_; ++k)
+        {
+        if (k >= a_.back().size() || a_.back()[k] != b_[k])
+            {
+            fsal_ = false;
+            }
+        }
+    }
+
+bool EmbeddedRungeKuttaIntegrator::advance(std::shared_ptr<Flux> flux,
+                                           std::shared_ptr<GrandPotential> grand,
+                                           std::shared_ptr<State> state,
+                                           double time)
+    {
+    // request flux buffers
+    for (const auto& t : state->getTypes())
+        {
+        flux->requestFluxBuffer(t, determineBufferShape(state, t));
+        }
+    prepareStages(state);
+
+    // exponents for proportional-integral control of the timestep
+    const double error_exponent = 1. / getLocalErrorExponent();
+    const double alpha = 0.7 * error_exponent;
+    const double beta = 0.4 * error_exponent;
+
+    // sign(time) = -1, 0, or +1
+    const char time_sign = (time > 0) - (time < 0);
+    double time_remain = std::abs(time);
+    double adaptive_last_remain = time_remain;
+    double last_error = 1.;
+    while (time_remain > 0)
+        {
+        const double dt = std::min(timestep_, time_remain);
+        const bool adapt = (use_adaptive_timestep_
+                            && std::abs(adaptive_last_remain - time_remain)
+                                   >= adaptive_timestep_delay_);
+        const double max_err = attemptStep(flux, grand, state, time_sign * dt);
+        if (!adapt)
+            {
+            acceptStep(state, time_sign * dt);
+            time_remain -= dt;
+            continue;
+            }
+        adaptive_last_remain = time_remain;
+
+        // if error is greater than tolerance, reject the step and try again
+        // otherwise, accept the step and scale up if possible
+        const double error = max_err / adaptive_timestep_tol_;
+        if (error > 1.)
+            {
+            timestep_ = dt * std::max(0.9 * std::pow(error, -error_exponent), 0.1);
+            if (timestep_ < adaptive_timestep_min_)
+                {
+                throw std::runtime_error("timestep decreased too much");
+                }
+            }
+        else
+            {
+            acceptStep(state, time_sign * dt);
+            time_remain -= dt;
+
+            // don't scale the timestep if it was shortened to finish
+            if (dt == timestep_)
+                {
+                double scale = 5.;
+                if (error > 0)
+                    {
+                    scale = 0.9 * std::pow(error, -alpha) * std::pow(last_error, beta);
+                    scale = std::min(std::max(scale, 0.2), 5.);
+                    }
+                timestep_ = dt * scale;
+                }
+            last_error = std::max(error, 1.e-4);
+            }
+        }
+    return true;
+    }
+
+void EmbeddedRungeKuttaIntegrator::step(std::shared_ptr<Flux> flux,
+                                        std::shared_ptr<GrandPotential> grand,
+                                        std::shared_ptr<State> state,
+                                        double timestep)
+    {
+    prepareStages(state);
+    attemptStep(flux, grand, state, timestep);
+    acceptStep(state, timestep);
+    }
+
+void EmbeddedRungeKuttaIntegrator::prepareStages(std::shared_ptr<State> state)
+    {
+    if (!stage_state_)
+        {
+        stage_state_ = std::make_shared<State>(*state);
+        }
+    else
+        {
+        *stage_state_ = *state;
+        }
+
+    rates_.resize(c_.size());
+    for (auto& rate : rates_)
+        {
+        state->matchFields(rate);
+        }
+    has_first_rate_ = false;
+    }
+
+double EmbeddedRungeKuttaIntegrator::attemptStep(std::shared_ptr<Flux> flux,
+                                                 std::shared_ptr<GrandPotential> grand,
+                                                 std::shared_ptr<State> state,
+                                                 double timestep)
+    {
+    const int num_stages = static_cast<int>(c_.size());
+    const double time = state->getTime();
+
+    // first stage is the rate at the current state, which may be known from the last step
+    if (!has_first_rate_)
+        {
+        computeRate(flux, grand, state, rates_[0]);
+        has_first_rate_ = true;
+        }
+
+    // evaluate the remaining stages using the pooled stage state
+    std::vector<double> weights;
+    std::vector<Field::ConstantView> rates;
+    for (int s = 1; s < num_stages; ++s)
+        {
+        for (const auto& t : state->getTypes())
+            {
+            gatherRates(a_[s], rates_, t, weights, rates);
+            combineRates(stage_state_->getField(t)->view(),
+                         state->getField(t)->const_view(),
+                         timestep,
+                         weights,
+                         rates);
+            }
+        stage_state_->setTime(time + c_[s] * timestep);
+        computeRate(flux, grand, stage_state_, rates_[s]);
+        }
+
+    // the last stage already holds the solution if it was evaluated there
+    if (!fsal_)
+        {
+        for (const auto& t : state->getTypes())
+            {
+            gatherRates(b_, rates_, t, weights, rates);
+            combineRates(stage_state_->getField(t)->view(),
+                         state->getField(t)->const_view(),
+                         timestep,
+                         weights,
+                         rates);
+            }
+        }
+
+    // local error is the difference from the embedded solution
+    double max_err = 0.;
+    for (const auto& t : state->getTypes())
+        {
+        gatherRates(b_err_, rates_, t, weights, rates);
+        const double type_max_err
+            = maxCombinedRate(timestep, weights, rates, state->getField(t)->shape());
+        max_err = std::max(max_err, type_max_err);
+        }
+    return state->getCommunicator()->max(max_err);
+    }
+
+void EmbeddedRungeKuttaIntegrator::acceptStep(std::shared_ptr<State> state, double timestep)
+    {
+    // the stage state holds the solution, so take its fields and reuse the old ones for stages
+    const double time = state->getTime();
+    state->swap(*stage_state_);
+    state->setTime(time + timestep);
+
+    // the last stage is the first stage of the next step
+    if (fsal_)
+        {
+        std::swap(rates_.front(), rates_.back());
+        }
+    has_first_rate_ = fsal_;
+    }
+
+void EmbeddedRungeKuttaIntegrator::computeRate(std::shared_ptr<Flux> flux,
+                                               std::shared_ptr<GrandPotential> grand,
+                                               std::shared_ptr<State> state,
+                                               TypeMap<std::shared_ptr<Field>>& rate)
+    {
+    const auto mesh = state->getMesh()->local().get();
+    flux->compute(grand, state);
+    for (const auto& t : state->getTypes())
+        {
+        auto j = flux->getFlux(t)->const_view();
+        assign(rate(t)->view(), integrateSurface(mesh, j) * inverseVolume(mesh));
+        }
+    }
+
+    } // namespace flyft
@@ -0,0 +1,162 @@
+#include "flyft/ensemble.h"
+
+#include "flyft/composite_external_potential.h"
+#include "flyft/composite_functional.h"
+
+#include <exception>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace flyft
+    {
+
+Ensemble::Ensemble() {}
+
+int Ensemble::size() const
+    {
+    return static_cast<int>(states_.size());
+    }
+
+void Ensemble::addSystem(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state)
+    {
+    if (!grand || !state)
+        {
+        throw std::invalid_argument("Ensemble systems need a grand potential and a state");
+        }
+    grands_.push_back(grand);
+    states_.push_back(state);
+    }
+
+void Ensemble::removeSystem(int index)
+    {
+    checkIndex(index);
+    grands_.erase(grands_.begin() + index);
+    states_.erase(states_.begin() + index);
+    }
+
+void Ensemble::clearSystems()
+    {
+    grands_.clear();
+    states_.clear();
+    }
+
+std::shared_ptr<GrandPotential> Ensemble::getGrandPotential(int index)
+    {
+    checkIndex(index);
+    return grands_[index];
+    }
+
+std::shared_ptr<State> Ensemble::getState(int index)
+    {
+    checkIndex(index);
+    return states_[index];
+    }
+
+std::vector<bool> Ensemble::solve(std::shared_ptr<Solver> solver)
+    {
+    if (!solver)
+        {
+        throw std::invalid_argument("Ensemble needs a solver");
+        }
+
+    // each system is solved by one thread, so the solver runs serially within it
+    const int num_systems = size();
+    auto& grands = grands_;
+    auto& states = states_;
+    std::vector<char> converged(num_systems, false);
+    std::exception_ptr error;
+#ifdef FLYFT_OPENMP
+    const bool concurrent = canSolveConcurrently();
+#pragma omp parallel for schedule(dynamic) default(none) if (concurrent) \
+    firstprivate(solver, num_systems) shared(grands, states, converged, error)
+#endif
+    for (int i = 0; i < num_systems; ++i)
+        {
+        // exceptions cannot leave a parallel region, so keep the first one and rethrow it
+        try
+            {
+            converged[i] = solver->solve(grands[i], states[i]);
+            }
+        catch (...)
+            {
+#ifdef FLYFT_OPENMP
+#pragma omp critical(flyft_ensemble_error)
+#endif
+                {
+                if (!error)
+                    {
+                    error = std::current_exception();
+                    }
+                }
+            }
+        }
+    if (error)
+        {
+        std::rethrow_exception(error);
+        }
+
+    return std::vector<bool>(converged.begin(), converged.end());
+    }
+
+void Ensemble::checkIndex(int index) const
+    {
+    if (index < 0 || index >= size())
+        {
+        throw std::out_of_range("Ensemble system index out of range");
+        }
+    }
+
+//! Add a functional and all the functionals it is composed of to a set
+static void collectFunctionals(std::shared_ptr<Functional> functional,
+                               std::unordered_set<const void*>& objects)
+    {
+    if (!functional || !objects.insert(functional.get()).second)
+        {
+        return;
+        }
+    if (auto composite = std::dynamic_pointer_cast<CompositeFunctional>(functional))
+        {
+        for (const auto& o : composite->getObjects())
+            {
+            collectFunctionals(o, objects);
+            }
+        }
+    else if (auto composite = std::dynamic_pointer_cast<CompositeExternalPotential>(functional))
+        {
+        for (const auto& o : composite->getObjects())
+            {
+            collectFunctionals(o, objects);
+            }
+        }
+    }
+
+bool Ensemble::canSolveConcurrently()
+    {
+    // objects that hold results of a compute cannot be shared between threads, including
+    // functionals nested inside composites
+    std::unordered_set<const void*> objects;
+    for (int i = 0; i < size(); ++i)
+        {
+        auto grand = grands_[i];
+        auto state = states_[i];
+        if (state->getCommunicator()->size() > 1)
+            {
+            return false;
+            }
+
+        std::unordered_set<const void*> system_objects = {grand.get(), state.get()};
+        collectFunctionals(grand->getIdealGasFunctional(), system_objects);
+        collectFunctionals(grand->getExcessFunctional(), system_objects);
+        collectFunctionals(grand->getExternalPotential(), system_objects);
+        for (const auto object : system_objects)
+            {
+            if (!objects.insert(object).second)
+                {
+                return false;
+                }
+            }
+        }
+    return true;
+    }
+
+    } // namespace flyft
@@ -1,5 +1,7 @@
 #include "flyft/explicit_euler_integrator.h"
 
+#include "flyft/field_expression.h"
+
 #include <cmath>
 
 namespace flyft
@@ -12,24 +14,29 @@ void ExplicitEulerIntegrator::step(std::shared_ptr<Flux> flux,
                                    std::shared_ptr<State> state,
                                    double timestep)
     {
-    // evaluate fluxes and apply to volumes
+    // evaluate fluxes and apply to volumes, which some fluxes can do in a single pass
+    flux->applyExplicitUpdate(grand, state, timestep);
+
+    state->advanceTime(timestep);
+    }
+
+void ExplicitEulerIntegrator::stepInto(std::shared_ptr<Flux> flux,
+                                       std::shared_ptr<GrandPotential> grand,
+                                       std::shared_ptr<State> state,
+                                       std::shared_ptr<State> next_state,
+                                       double timestep)
+    {
+    // the flux of the state is kept, so repeated steps from it reuse the same flux
     const auto mesh = state->getMesh()->local().get();
     flux->compute(grand, state);
     for (const auto& t : state->getTypes())
         {
-        auto rho = state->getField(t)->view();
         auto j = flux->getFlux(t)->const_view();
-#ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(timestep, mesh) shared(rho, j)
-#endif
-        for (int idx = 0; idx < mesh->shape(); ++idx)
-            {
-            const auto rate = mesh->integrateSurface(idx, j) / mesh->volume(idx);
-            rho(idx) += timestep * rate;
-            }
+        assign(next_state->getField(t)->view(),
+               state->getField(t)->const_view()
+                   + timestep * (integrateSurface(mesh, j) * inverseVolume(mesh)));
         }
-
-    state->advanceTime(timestep);
+    next_state->setTime(state->getTime() + timestep);
     }
 
     } // namespace flyft
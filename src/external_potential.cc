@@ -1,5 +1,7 @@
 #include "flyft/external_potential.h"
 
+#include <stdexcept>
+
 namespace flyft
     {
 
@@ -32,6 +34,8 @@ void ExternalPotential::_compute(std::shared_ptr<State> state, bool compute_valu
     if (compute_potentials_)
         {
         computePotentials(state);
+        computeActiveRanges(state);
+        computeBoltzmannFactors(state);
         compute_potentials_ = false;
         compute_potentials_mesh_ = state->getMesh()->local();
         }
@@ -71,4 +75,61 @@ void ExternalPotential::_compute(std::shared_ptr<State> state, bool compute_valu
         }
     }
 
+std::pair<int, int> ExternalPotential::getActiveRange(const std::string& type) const
+    {
+    if (!active_ranges_.contains(type))
+        {
+        throw std::runtime_error("Active range not computed for type");
+        }
+    return active_ranges_(type);
+    }
+
+void ExternalPotential::computeActiveRanges(std::shared_ptr<State> state)
+    {
+    const int shape = state->getMesh()->local()->shape();
+    active_ranges_.clear();
+    for (const auto& t : state->getTypes())
+        {
+        auto d = derivatives_(t)->const_view();
+        int first = 0;
+        while (first < shape && std::isinf(d(first)) && d(first) > 0)
+            {
+            ++first;
+            }
+        int last = shape;
+        while (last > first && std::isinf(d(last - 1)) && d(last - 1) > 0)
+            {
+            --last;
+            }
+        active_ranges_[t] = std::make_pair(first, last);
+        }
+    }
+
+std::shared_ptr<const Field> ExternalPotential::getBoltzmannFactor(const std::string& type) const
+    {
+    if (!boltzmann_factors_.contains(type))
+        {
+        throw std::runtime_error("Boltzmann factor not computed for type");
+        }
+    return boltzmann_factors_(type);
+    }
+
+void ExternalPotential::computeBoltzmannFactors(std::shared_ptr<State> state)
+    {
+    const auto mesh = state->getMesh()->local().get();
+    state->matchFields(boltzmann_factors_);
+    for (const auto& t : state->getTypes())
+        {
+        auto d = derivatives_(t)->const_view();
+        auto b = boltzmann_factors_(t)->view();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(mesh) shared(d, b)
+#endif
+        for (int idx = 0; idx < mesh->shape(); ++idx)
+            {
+            b(idx) = std::exp(-d(idx));
+            }
+        }
+    }
+
     } // namespace flyft
@@ -1,5 +1,7 @@
 #include "flyft/flux.h"
 
+#include "flyft/field_expression.h"
+
 #include <algorithm>
 
 namespace flyft
@@ -9,6 +11,35 @@ Flux::Flux() {}
 
 Flux::~Flux() {}
 
+Flux::Token Flux::compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state)
+    {
+    bool needs_compute = setup(grand, state);
+    if (!needs_compute)
+        {
+        return token_;
+        }
+    else
+        {
+        _compute(grand, state);
+        return finalize(grand, state);
+        }
+    }
+
+void Flux::applyExplicitUpdate(std::shared_ptr<GrandPotential> grand,
+                               std::shared_ptr<State> state,
+                               double timestep)
+    {
+    // evaluate fluxes and apply to volumes
+    const auto mesh = state->getMesh()->local().get();
+    compute(grand, state);
+    for (const auto& t : state->getTypes())
+        {
+        auto rho = state->getField(t)->view();
+        auto j = fluxes_(t)->const_view();
+        assign(rho, rho + timestep * (integrateSurface(mesh, j) * inverseVolume(mesh)));
+        }
+    }
+
 const TypeMap<std::shared_ptr<Field>>& Flux::getFluxes()
     {
     return fluxes_;
@@ -38,7 +69,7 @@ void Flux::requestFluxBuffer(const std::string& type, int buffer_request)
         }
     }
 
-void Flux::setup(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state)
+bool Flux::setup(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state)
     {
     if (!validateConstraints(grand, state))
         {
@@ -53,8 +84,81 @@ void Flux::setup(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> s
         grand->requestDerivativeBuffer(t, buffer_request);
         }
 
-    // match up flux fields to state
+    // match up flux fields to state, and attach as dependencies
+    TypeMap<Identifier> flux_ids;
+    for (const auto& it : fluxes_)
+        {
+        flux_ids[it.first] = it.second->id();
+        }
     state->matchFields(fluxes_, buffer_requests_);
+    for (const auto& it : flux_ids)
+        {
+        // type removed or field is a new object
+        if (!fluxes_.contains(it.first) || fluxes_[it.first]->id() != it.second)
+            {
+            compute_depends_.remove(it.second);
+            }
+        }
+    for (const auto& it : fluxes_)
+        {
+        compute_depends_.add(it.second.get());
+        }
+
+    // evaluate functionals separately to handle ideal as special case. these are only recomputed
+    // if the state or their parameters have changed, so their derivatives are reused between
+    // fluxes and across repeated evaluations on the same state.
+    auto excess = grand->getExcessFunctional();
+    auto external = grand->getExternalPotential();
+    trackFunctional(compute_excess_, excess);
+    trackFunctional(compute_external_, external);
+    if (excess)
+        {
+        excess->compute(state, false);
+        }
+    if (external)
+        {
+        external->compute(state, false);
+        }
+
+    // sync fields as a precaution, but this will already likely have been done by functionals
+    state->syncFields();
+
+    // return whether evaluation is required
+    bool compute = ((!compute_token_ || token_ != compute_token_)
+                    || (!compute_state_token_ || state->token() != compute_state_token_)
+                    || compute_depends_.changed());
+
+    return compute;
+    }
+
+Flux::Token Flux::finalize(std::shared_ptr<GrandPotential> /*grand*/, std::shared_ptr<State> state)
+    {
+    // stage changes after a compute
+    token_.stageAndCommit();
+
+    // capture dependencies
+    compute_token_ = token_;
+    compute_state_token_ = state->token();
+    compute_depends_.capture();
+
+    return compute_token_;
+    }
+
+void Flux::trackFunctional(std::shared_ptr<Functional>& current,
+                           std::shared_ptr<Functional> object)
+    {
+    if (object != current)
+        {
+        if (current)
+            {
+            compute_depends_.remove(current->id());
+            }
+        if (object)
+            {
+            compute_depends_.add(object.get());
+            }
+        current = object;
+        }
     }
 
 bool Flux::validateConstraints(std::shared_ptr<GrandPotential> grand,
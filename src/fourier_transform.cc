@@ -1,36 +1,98 @@
 #include "flyft/fourier_transform.h"
 
 #include <algorithm>
+#include <mutex>
+#include <stdexcept>
 #ifdef FLYFT_OPENMP
 #include <omp.h>
 #endif
 
+// FFTW functions for the precision of the fields
+#ifdef FLYFT_SINGLE_PRECISION
+#define FLYFT_FFTW(name) fftwf_##name
+#else
+#define FLYFT_FFTW(name) fftw_##name
+#endif // FLYFT_SINGLE_PRECISION
+
 namespace flyft
     {
-FourierTransform::FourierTransform(double L, int N) : L_(L), N_(N), kmesh_(L, N), space_(RealSpace)
+//! FFTW planning is not thread safe, so only one transform can plan at a time
+static std::mutex fftw_planner_mutex;
+
+FourierTransform::FourierTransform(double L, int N) : FourierTransform(L, N, Symmetry::periodic)
+    {
+    }
+
+FourierTransform::FourierTransform(double L, int N, Symmetry symmetry)
+    : FourierTransform(L, N, symmetry, false)
+    {
+    }
+
+FourierTransform::FourierTransform(double L, int N, Symmetry symmetry, bool pad)
+    : L_(L), N_(N), padded_N_(pad ? fastSize(N) : N), symmetry_(symmetry),
+      kmesh_(L * static_cast<double>(padded_N_) / N, padded_N_, symmetry), space_(RealSpace)
     {
+    std::lock_guard<std::mutex> lock(fftw_planner_mutex);
 #ifdef FLYFT_OPENMP
-    // use all available OpenMP threads
-    fftw_init_threads();
-    fftw_plan_with_nthreads(omp_get_max_threads());
+    // use all available OpenMP threads, unless already inside a parallel region
+    FLYFT_FFTW(init_threads)();
+    FLYFT_FFTW(plan_with_nthreads)(omp_in_parallel() ? 1 : omp_get_max_threads());
 #endif
 
-    // this is the doc'd size of "real" memory required for the r2c / c2r transform
-    data_ = fftw_alloc_real(2 * (N_ / 2 + 1));
+    if (symmetry_ == Symmetry::periodic)
+        {
+        // this is the doc'd size of "real" memory required for the r2c / c2r transform
+        data_ = FLYFT_FFTW(alloc_real)(2 * (padded_N_ / 2 + 1));
 
-    r2c_plan_
-        = fftw_plan_dft_r2c_1d(N_, data_, reinterpret_cast<fftw_complex*>(data_), FFTW_ESTIMATE);
+        auto complex_data = reinterpret_cast<FLYFT_FFTW(complex)*>(data_);
+        forward_plan_
+            = FLYFT_FFTW(plan_dft_r2c_1d)(padded_N_, data_, complex_data, FFTW_ESTIMATE);
+        backward_plan_
+            = FLYFT_FFTW(plan_dft_c2r_1d)(padded_N_, complex_data, data_, FFTW_ESTIMATE);
+        }
+    else
+        {
+        // the real-to-real transforms are done in place, and the backward transform of each
+        // kind is the inverse of the forward transform up to normalization
+        fftw_r2r_kind forward_kind, backward_kind;
+        if (symmetry_ == Symmetry::even)
+            {
+            forward_kind = FFTW_REDFT10;
+            backward_kind = FFTW_REDFT01;
+            }
+        else if (symmetry_ == Symmetry::odd)
+            {
+            forward_kind = FFTW_RODFT10;
+            backward_kind = FFTW_RODFT01;
+            }
+        else if (symmetry_ == Symmetry::odd_even)
+            {
+            forward_kind = backward_kind = FFTW_RODFT11;
+            }
+        else if (symmetry_ == Symmetry::even_odd)
+            {
+            forward_kind = backward_kind = FFTW_REDFT11;
+            }
+        else
+            {
+            throw std::invalid_argument("Unknown symmetry for Fourier transform");
+            }
 
-    c2r_plan_
-        = fftw_plan_dft_c2r_1d(N_, reinterpret_cast<fftw_complex*>(data_), data_, FFTW_ESTIMATE);
+        data_ = FLYFT_FFTW(alloc_real)(padded_N_);
+        forward_plan_
+            = FLYFT_FFTW(plan_r2r_1d)(padded_N_, data_, data_, forward_kind, FFTW_ESTIMATE);
+        backward_plan_
+            = FLYFT_FFTW(plan_r2r_1d)(padded_N_, data_, data_, backward_kind, FFTW_ESTIMATE);
+        }
     }
 
 FourierTransform::~FourierTransform()
     {
+    std::lock_guard<std::mutex> lock(fftw_planner_mutex);
     if (data_)
-        fftw_free(data_);
-    fftw_destroy_plan(r2c_plan_);
-    fftw_destroy_plan(c2r_plan_);
+        FLYFT_FFTW(free)(data_);
+    FLYFT_FFTW(destroy_plan)(forward_plan_);
+    FLYFT_FFTW(destroy_plan)(backward_plan_);
     }
 
 FourierTransform::RealView FourierTransform::view_real() const
@@ -55,6 +117,7 @@ void FourierTransform::setRealData(const RealView& data)
     {
     RealView view(data_, DataLayout(N_));
     std::copy(data.begin(), data.end(), view.begin());
+    padRealData();
     space_ = RealSpace;
     }
 
@@ -62,16 +125,48 @@ void FourierTransform::setRealData(const ConstantRealView& data)
     {
     RealView view(data_, DataLayout(N_));
     std::copy(data.begin(), data.end(), view.begin());
+    padRealData();
     space_ = RealSpace;
     }
 
+void FourierTransform::padRealData()
+    {
+    // continue the data without a jump: mirror about the upper end with its symmetry, or bridge
+    // linearly back to the first point for periodic data
+    const int pad = padded_N_ - N_;
+    if (symmetry_ == Symmetry::periodic)
+        {
+        const FieldValue first = data_[0];
+        const FieldValue last = data_[N_ - 1];
+        for (int idx = 0; idx < pad; ++idx)
+            {
+            const FieldValue t = static_cast<FieldValue>(idx + 1) / (pad + 1);
+            data_[N_ + idx] = (1 - t) * last + t * first;
+            }
+        }
+    else if (symmetry_ == Symmetry::even || symmetry_ == Symmetry::odd_even)
+        {
+        for (int idx = 0; idx < pad; ++idx)
+            {
+            data_[N_ + idx] = data_[N_ - 1 - idx];
+            }
+        }
+    else
+        {
+        for (int idx = 0; idx < pad; ++idx)
+            {
+            data_[N_ + idx] = -data_[N_ - 1 - idx];
+            }
+        }
+    }
+
 FourierTransform::ReciprocalView FourierTransform::view_reciprocal() const
     {
     if (space_ != ReciprocalSpace)
         {
         // raise error, buffer not valid
         }
-    return ReciprocalView(reinterpret_cast<std::complex<double>*>(data_),
+    return ReciprocalView(reinterpret_cast<std::complex<FieldValue>*>(data_),
                           DataLayout(kmesh_.shape()));
     }
 
@@ -81,20 +176,46 @@ FourierTransform::ConstantReciprocalView FourierTransform::const_view_reciprocal
         {
         // raise error, buffer not valid
         }
-    return ConstantReciprocalView(reinterpret_cast<const std::complex<double>*>(data_),
+    return ConstantReciprocalView(reinterpret_cast<const std::complex<FieldValue>*>(data_),
                                   DataLayout(kmesh_.shape()));
     }
 
 void FourierTransform::setReciprocalData(const ReciprocalView& data)
     {
-    ReciprocalView view(reinterpret_cast<std::complex<double>*>(data_), DataLayout(kmesh_.shape()));
+    ReciprocalView view(reinterpret_cast<std::complex<FieldValue>*>(data_),
+                        DataLayout(kmesh_.shape()));
     std::copy(data.begin(), data.end(), view.begin());
     space_ = ReciprocalSpace;
     }
 
 void FourierTransform::setReciprocalData(const ConstantReciprocalView& data)
     {
-    ReciprocalView view(reinterpret_cast<std::complex<double>*>(data_), DataLayout(kmesh_.shape()));
+    ReciprocalView view(reinterpret_cast<std::complex<FieldValue>*>(data_),
+                        DataLayout(kmesh_.shape()));
+    std::copy(data.begin(), data.end(), view.begin());
+    space_ = ReciprocalSpace;
+    }
+
+FourierTransform::RealView FourierTransform::view_coefficients() const
+    {
+    return RealView(data_, DataLayout(kmesh_.shape()));
+    }
+
+FourierTransform::ConstantRealView FourierTransform::const_view_coefficients() const
+    {
+    return ConstantRealView(data_, DataLayout(kmesh_.shape()));
+    }
+
+void FourierTransform::setCoefficients(const RealView& data)
+    {
+    RealView view(data_, DataLayout(kmesh_.shape()));
+    std::copy(data.begin(), data.end(), view.begin());
+    space_ = ReciprocalSpace;
+    }
+
+void FourierTransform::setCoefficients(const ConstantRealView& data)
+    {
+    RealView view(data_, DataLayout(kmesh_.shape()));
     std::copy(data.begin(), data.end(), view.begin());
     space_ = ReciprocalSpace;
     }
@@ -108,14 +229,16 @@ void FourierTransform::transform()
     {
     if (space_ == RealSpace)
         {
-        fftw_execute(r2c_plan_);
+        FLYFT_FFTW(execute)(forward_plan_);
         space_ = ReciprocalSpace;
         }
     else
         {
-        // execute inverse FFT and renormalize by N (FFTW does not)
-        fftw_execute(c2r_plan_);
-        std::transform(data_, data_ + N_, data_, [&](auto x) { return x / N_; });
+        // execute inverse FFT and renormalize by the logical size (FFTW does not), which is
+        // twice as large as the padded size for the real-to-real transforms
+        FLYFT_FFTW(execute)(backward_plan_);
+        const int norm = (symmetry_ == Symmetry::periodic) ? padded_N_ : 2 * padded_N_;
+        std::transform(data_, data_ + N_, data_, [&](auto x) { return x / norm; });
         space_ = RealSpace;
         }
     }
@@ -130,20 +253,76 @@ int FourierTransform::getN() const
     return N_;
     }
 
+int FourierTransform::getPaddedN() const
+    {
+    return padded_N_;
+    }
+
+int FourierTransform::fastSize(int N)
+    {
+    // FFTW is fastest for sizes with only small prime factors, so search upward for the first
+    // size that is a product of 2, 3, 5, and 7
+    int size = std::max(N, 1);
+    while (true)
+        {
+        int remainder = size;
+        for (int factor : {2, 3, 5, 7})
+            {
+            while (remainder % factor == 0)
+                {
+                remainder /= factor;
+                }
+            }
+        if (remainder == 1)
+            {
+            return size;
+            }
+        ++size;
+        }
+    }
+
+FourierTransform::Symmetry FourierTransform::getSymmetry() const
+    {
+    return symmetry_;
+    }
+
 const FourierTransform::Wavevectors& FourierTransform::getWavevectors() const
     {
     return kmesh_;
     }
 
-FourierTransform::Wavevectors::Wavevectors(double L, int N)
+FourierTransform::Wavevectors::Wavevectors(double L, int N, Symmetry symmetry)
     {
-    step_ = (2. * M_PI) / L;
-    shape_ = N / 2 + 1;
+    if (symmetry == Symmetry::periodic)
+        {
+        step_ = (2. * M_PI) / L;
+        offset_ = 0;
+        shape_ = N / 2 + 1;
+        }
+    else
+        {
+        // the wavevectors are multiples of pi/L: the sines skip k = 0, and the series with
+        // different symmetry at each end are shifted by half a step
+        step_ = M_PI / L;
+        if (symmetry == Symmetry::odd)
+            {
+            offset_ = 1;
+            }
+        else if (symmetry == Symmetry::odd_even || symmetry == Symmetry::even_odd)
+            {
+            offset_ = 0.5;
+            }
+        else
+            {
+            offset_ = 0;
+            }
+        shape_ = N;
+        }
     }
 
 double FourierTransform::Wavevectors::operator()(int i) const
     {
-    return static_cast<double>(i) * step_;
+    return (static_cast<double>(i) + offset_) * step_;
     }
 
 int FourierTransform::Wavevectors::shape() const
@@ -1,6 +1,9 @@
 #include "flyft/grand_potential.h"
 
+#include "flyft/field_expression.h"
+
 #include <algorithm>
+#include <vector>
 
 namespace flyft
     {
@@ -32,55 +35,51 @@ void GrandPotential::_compute(std::shared_ptr<State> state, bool compute_value)
     {
     const auto mesh = state->getMesh()->local().get();
 
-    // sum up contributions to derivatives for each type
+    // sum up contributions to derivatives for each type, subtracting the chemical potential
+    // when the component is open
     double constraint_value = 0.0;
     for (const auto& t : state->getTypes())
         {
         auto d = derivatives_(t)->full_view();
-        auto did = (ideal_) ? ideal_->getDerivative(t)->const_full_view() : Field::ConstantView();
-        auto dex = (excess_) ? excess_->getDerivative(t)->const_full_view() : Field::ConstantView();
-        auto dext
-            = (external_) ? external_->getDerivative(t)->const_full_view() : Field::ConstantView();
-#ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(mesh) shared(d, did, dex, dext)
-#endif
-        for (int idx = 0; idx < d.size(); ++idx)
+        std::vector<Field::ConstantView> terms;
+        if (ideal_)
             {
-            double deriv = 0.;
-            if (did)
-                {
-                deriv += did(idx);
-                }
-            if (dex)
-                {
-                deriv += dex(idx);
-                }
-            if (dext)
-                {
-                deriv += dext(idx);
-                }
-            d(idx) = deriv;
+            terms.push_back(ideal_->getDerivative(t)->const_full_view());
+            }
+        if (excess_)
+            {
+            terms.push_back(excess_->getDerivative(t)->const_full_view());
+            }
+        if (external_)
+            {
+            terms.push_back(external_->getDerivative(t)->const_full_view());
             }
 
-        // subtract chemical potential part when component is open
         auto constraint_type = constraint_types_(t);
         if (constraint_type == Constraint::mu)
             {
+            // the chemical potential is uniform, so it is also subtracted in the buffer where the
+            // other terms hold the values of the neighboring points
             const auto mu_bulk = constraints_(t);
-            auto rho = state->getField(t)->const_view();
+            assign(d, sum(terms) - mu_bulk);
+
+            if (compute_value)
+                {
+                auto rho = state->getField(t)->const_view();
 #ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(mesh, mu_bulk) \
-    shared(rho, d, compute_value) reduction(- : constraint_value)
+#pragma omp parallel for schedule(static) default(none) firstprivate(mesh, mu_bulk) shared(rho) \
+    reduction(- : constraint_value)
 #endif
-            for (int idx = 0; idx < mesh->shape(); ++idx)
-                {
-                d(idx) -= mu_bulk;
-                if (compute_value)
+                for (int idx = 0; idx < mesh->shape(); ++idx)
                     {
                     constraint_value -= mu_bulk * mesh->integrateVolume(idx, rho);
                     }
                 }
             }
+        else
+            {
+            assign(d, sum(terms));
+            }
         }
 
     // reduce and add constraint contribution to value
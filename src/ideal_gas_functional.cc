@@ -1,5 +1,7 @@
 #include "flyft/ideal_gas_functional.h"
 
+#include <algorithm>
+
 namespace flyft
     {
 
@@ -51,9 +53,11 @@ void IdealGasFunctional::_compute(std::shared_ptr<State> state, bool compute_val
         const auto vol = volumes_(t);
         const auto mesh = state->getMesh()->local().get();
 
-        // compute edges of each derivative first and put in flight
+        // compute edges of each derivative first and put in flight, including the point that a
+        // reflecting lower boundary mirrors into the buffer
         const auto deriv_buffer = deriv->buffer_shape();
-        for (int idx = 0; idx < deriv_buffer; ++idx)
+        const int lower_edge = std::min(deriv_buffer + 1, mesh->shape() - deriv_buffer);
+        for (int idx = 0; idx < lower_edge; ++idx)
             {
             computeFunctional(idx, d, value_, f, vol, mesh, compute_value);
             }
@@ -65,10 +69,10 @@ void IdealGasFunctional::_compute(std::shared_ptr<State> state, bool compute_val
 
 // compute on interior points
 #ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(mesh, vol) \
+#pragma omp parallel for schedule(static) default(none) firstprivate(mesh, vol, lower_edge) \
     shared(f, d, compute_value, deriv_buffer) reduction(+ : value_)
 #endif
-        for (int idx = deriv_buffer; idx < mesh->shape() - deriv_buffer; ++idx)
+        for (int idx = lower_edge; idx < mesh->shape() - deriv_buffer; ++idx)
             {
             computeFunctional(idx, d, value_, f, vol, mesh, compute_value);
             }
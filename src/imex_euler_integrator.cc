@@ -0,0 +1,329 @@
+#include "flyft/imex_euler_integrator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace flyft
+    {
+
+// values each rank contributes to the reduced system for each type:
+// first row (lower, diag, upper, rhs), then the local solution and responses to the first point
+// on this rank and the next rank at the second point and at the last point
+static const int reduced_size = 10;
+
+//! Solve a tridiagonal system for several right-hand sides by the Thomas algorithm
+/*!
+ * Row i reads lower[i] x[i-1] + diag[i] x[i] + upper[i] x[i+1] = rhs[i] for 0 <= i < n, and the
+ * couplings outside the system are ignored. Each right-hand side is overwritten by its solution.
+ * The scratch array must hold n values.
+ */
+static void solveTridiagonal(int n,
+                             const double* lower,
+                             const double* diag,
+                             const double* upper,
+                             double* scratch,
+                             const std::vector<double*>& rhs)
+    {
+    scratch[0] = upper[0] / diag[0];
+    for (auto x : rhs)
+        {
+        x[0] /= diag[0];
+        }
+    for (int i = 1; i < n; ++i)
+        {
+        const double inv_pivot = 1. / (diag[i] - lower[i] * scratch[i - 1]);
+        scratch[i] = upper[i] * inv_pivot;
+        for (auto x : rhs)
+            {
+            x[i] = (x[i] - lower[i] * x[i - 1]) * inv_pivot;
+            }
+        }
+    for (int i = n - 2; i >= 0; --i)
+        {
+        for (auto x : rhs)
+            {
+            x[i] -= scratch[i] * x[i + 1];
+            }
+        }
+    }
+
+//! Solve a cyclic tridiagonal system, where lower[0] couples to x[n-1] and upper[n-1] to x[0]
+static std::vector<double> solveCyclicTridiagonal(std::vector<double> lower,
+                                                  std::vector<double> diag,
+                                                  std::vector<double> upper,
+                                                  std::vector<double> rhs)
+    {
+    const int n = static_cast<int>(diag.size());
+    if (n == 1)
+        {
+        rhs[0] /= lower[0] + diag[0] + upper[0];
+        return rhs;
+        }
+    else if (n == 2)
+        {
+        // both couplings of each row are to the other row
+        const double upper_0 = upper[0] + lower[0];
+        const double lower_1 = lower[1] + upper[1];
+        const double det = diag[0] * diag[1] - upper_0 * lower_1;
+        return {(diag[1] * rhs[0] - upper_0 * rhs[1]) / det,
+                (diag[0] * rhs[1] - lower_1 * rhs[0]) / det};
+        }
+
+    std::vector<double> scratch(n);
+    const double corner_lower = upper[n - 1];
+    const double corner_upper = lower[0];
+    if (corner_lower == 0. && corner_upper == 0.)
+        {
+        solveTridiagonal(n, lower.data(), diag.data(), upper.data(), scratch.data(), {rhs.data()});
+        return rhs;
+        }
+
+    // Sherman-Morrison correction for the corners
+    const double gamma = -diag[0];
+    diag[0] -= gamma;
+    diag[n - 1] -= corner_lower * corner_upper / gamma;
+    std::vector<double> u(n, 0.);
+    u[0] = gamma;
+    u[n - 1] = corner_lower;
+    solveTridiagonal(n,
+                     lower.data(),
+                     diag.data(),
+                     upper.data(),
+                     scratch.data(),
+                     {rhs.data(), u.data()});
+    const double factor = (rhs[0] + corner_upper * rhs[n - 1] / gamma)
+                          / (1. + u[0] + corner_upper * u[n - 1] / gamma);
+    for (int i = 0; i < n; ++i)
+        {
+        rhs[i] -= factor * u[i];
+        }
+    return rhs;
+    }
+
+IMEXEulerIntegrator::IMEXEulerIntegrator(double timestep) : Integrator(timestep) {}
+
+void IMEXEulerIntegrator::step(std::shared_ptr<Flux> flux,
+                               std::shared_ptr<GrandPotential> grand,
+                               std::shared_ptr<State> state,
+                               double timestep)
+    {
+    stepInto(flux, grand, state, state, timestep);
+    }
+
+void IMEXEulerIntegrator::stepInto(std::shared_ptr<Flux> flux,
+                                   std::shared_ptr<GrandPotential> grand,
+                                   std::shared_ptr<State> state,
+                                   std::shared_ptr<State> next_state,
+                                   double timestep)
+    {
+    auto brownian_flux = std::dynamic_pointer_cast<BrownianDiffusiveFlux>(flux);
+    if (!brownian_flux)
+        {
+        throw std::invalid_argument("IMEX integrator requires a Brownian diffusive flux");
+        }
+
+    // the explicit rate uses the full flux, and the Fickian part at the current state is
+    // swapped for the next state by solving for the change in density
+    flux->compute(grand, state);
+
+    const auto mesh = state->getMesh()->local().get();
+    const int shape = mesh->shape();
+    const auto types = state->getTypes();
+    const int num_types = static_cast<int>(types.size());
+    rhs_.resize(num_types * shape);
+    lower_response_.resize(num_types * shape);
+    upper_response_.resize(num_types * shape);
+    std::vector<double> reduced(reduced_size * num_types);
+    for (int k = 0; k < num_types; ++k)
+        {
+        const int offset = k * shape;
+        assemble(brownian_flux, grand, state, types[k], timestep, &rhs_[offset]);
+        solveLocal(&rhs_[offset],
+                   &lower_response_[offset],
+                   &upper_response_[offset],
+                   &reduced[reduced_size * k]);
+        }
+
+    // couple the ranks through the first point on each, which every rank solves for itself
+    auto comm = state->getCommunicator();
+    const auto all_reduced = comm->allgather(reduced);
+    const int num_ranks = comm->size();
+    const int rank = comm->rank();
+    for (int k = 0; k < num_types; ++k)
+        {
+        std::vector<double> lower(num_ranks);
+        std::vector<double> diag(num_ranks);
+        std::vector<double> upper(num_ranks);
+        std::vector<double> rhs(num_ranks);
+        for (int r = 0; r < num_ranks; ++r)
+            {
+            const int left = (r + num_ranks - 1) % num_ranks;
+            const double* cur = &all_reduced[reduced_size * (r * num_types + k)];
+            const double* prev = &all_reduced[reduced_size * (left * num_types + k)];
+            lower[r] = cur[0] * prev[8];
+            diag[r] = cur[1] + cur[0] * prev[9] + cur[2] * cur[5];
+            upper[r] = cur[2] * cur[6];
+            rhs[r] = cur[3] - cur[0] * prev[7] - cur[2] * cur[4];
+            }
+        const auto first = solveCyclicTridiagonal(lower, diag, upper, rhs);
+        const double first_cur = first[rank];
+        const double first_next = first[(rank + 1) % num_ranks];
+
+        // apply the change in density, which also works in place when the states are the same
+        const int offset = k * shape;
+        const double* y = &rhs_[offset];
+        const double* p = &lower_response_[offset];
+        const double* q = &upper_response_[offset];
+        auto rho = state->getField(types[k])->const_view();
+        auto next_rho = next_state->getField(types[k])->view();
+        next_rho(0) = rho(0) + first_cur;
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) \
+    firstprivate(shape, y, p, q, first_cur, first_next) shared(rho, next_rho)
+#endif
+        for (int idx = 1; idx < shape; ++idx)
+            {
+            next_rho(idx) = rho(idx) + (y[idx] + p[idx] * first_cur + q[idx] * first_next);
+            }
+        }
+
+    next_state->setTime(state->getTime() + timestep);
+    }
+
+void IMEXEulerIntegrator::assemble(std::shared_ptr<BrownianDiffusiveFlux> flux,
+                                   std::shared_ptr<GrandPotential> grand,
+                                   std::shared_ptr<State> state,
+                                   const std::string& type,
+                                   double timestep,
+                                   double* rhs)
+    {
+    const auto mesh = state->getMesh()->local().get();
+    const int shape = mesh->shape();
+    const auto areas = mesh->areas();
+    const auto inv_volumes = mesh->inverse_volumes();
+    const auto lower_bc = mesh->lower_boundary_condition();
+    const auto upper_bc = mesh->upper_boundary_condition();
+    const bool lower_coupled
+        = (lower_bc == BoundaryType::periodic || lower_bc == BoundaryType::internal);
+    const bool upper_coupled
+        = (upper_bc == BoundaryType::periodic || upper_bc == BoundaryType::internal);
+
+    const double D = flux->getDiffusivities()(type);
+    auto external = grand->getExternalPotential();
+    auto V = (external) ? external->getDerivative(type)->const_view() : Field::ConstantView();
+    auto j = flux->getFlux(type)->const_view();
+
+    // weight of the Fickian flux through each edge, matching where the flux is zeroed
+    scratch_.resize(shape + 1);
+    double* weights = scratch_.data();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) \
+    firstprivate(shape, D, mesh, areas, lower_bc, upper_bc, weights) shared(V)
+#endif
+    for (int idx = 0; idx <= shape; ++idx)
+        {
+        if ((idx == 0 && (lower_bc == BoundaryType::reflect || lower_bc == BoundaryType::repeat))
+            || (idx == shape - 1 && upper_bc == BoundaryType::reflect)
+            || (idx == shape && upper_bc == BoundaryType::zero)
+            || (V && (std::isinf(V(idx)) || std::isinf(V(idx - 1)))))
+            {
+            weights[idx] = 0.;
+            }
+        else
+            {
+            weights[idx] = D * areas[idx] * mesh->gradient(idx, 0., 1.);
+            }
+        }
+
+    // rows of I - dt L with the explicit rate as the right-hand side
+    lower_.resize(shape);
+    diag_.resize(shape);
+    upper_.resize(shape);
+    double* lower = lower_.data();
+    double* diag = diag_.data();
+    double* upper = upper_.data();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) \
+    firstprivate(shape, timestep, mesh, inv_volumes, weights, lower, diag, upper, rhs) shared(j)
+#endif
+    for (int idx = 0; idx < shape; ++idx)
+        {
+        lower[idx] = -timestep * weights[idx] * inv_volumes[idx];
+        upper[idx] = -timestep * weights[idx + 1] * inv_volumes[idx];
+        diag[idx] = 1. - lower[idx] - upper[idx];
+        rhs[idx] = timestep * mesh->integrateSurface(idx, j) * inv_volumes[idx];
+        }
+
+    // density outside an uncoupled lower edge is zero or already accounted for
+    if (!lower_coupled)
+        {
+        lower[0] = 0.;
+        }
+
+    // flux through an uncoupled upper edge is zero or copied from the last interior edge
+    if (!upper_coupled)
+        {
+        const int last = shape - 1;
+        upper[last] = 0.;
+        if (upper_bc == BoundaryType::repeat || upper_bc == BoundaryType::reflect)
+            {
+            double weight = weights[last];
+            if (weight != 0.)
+                {
+                weight -= D * areas[shape] * mesh->gradient(last, 0., 1.);
+                }
+            lower[last] = -timestep * weight * inv_volumes[last];
+            diag[last] = 1. - lower[last];
+            }
+        }
+    }
+
+void IMEXEulerIntegrator::solveLocal(double* rhs,
+                                     double* lower_response,
+                                     double* upper_response,
+                                     double* reduced)
+    {
+    const int shape = static_cast<int>(diag_.size());
+    reduced[0] = lower_[0];
+    reduced[1] = diag_[0];
+    reduced[2] = upper_[0];
+    reduced[3] = rhs[0];
+
+    // with one point, the next point is the first point on the next rank
+    if (shape == 1)
+        {
+        rhs[0] = 0.;
+        lower_response[0] = 1.;
+        upper_response[0] = 0.;
+        reduced[4] = 0.;
+        reduced[5] = 0.;
+        reduced[6] = 1.;
+        reduced[7] = 0.;
+        reduced[8] = 1.;
+        reduced[9] = 0.;
+        return;
+        }
+
+    // remaining rows depend on the first point here and the first point on the next rank
+    const int last = shape - 1;
+    std::fill(lower_response, lower_response + shape, 0.);
+    std::fill(upper_response, upper_response + shape, 0.);
+    lower_response[1] = -lower_[1];
+    upper_response[last] += -upper_[last];
+    solveTridiagonal(last,
+                     &lower_[1],
+                     &diag_[1],
+                     &upper_[1],
+                     scratch_.data(),
+                     {rhs + 1, lower_response + 1, upper_response + 1});
+
+    reduced[4] = rhs[1];
+    reduced[5] = lower_response[1];
+    reduced[6] = upper_response[1];
+    reduced[7] = rhs[last];
+    reduced[8] = lower_response[last];
+    reduced[9] = upper_response[last];
+    }
+
+    } // namespace flyft
@@ -0,0 +1,357 @@
+#include "flyft/implicit_integrator.h"
+
+#include "flyft/field_expression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace flyft
+    {
+
+//! Global dot product of two sets of fields on the interior points
+static double dot(const TypeMap<std::shared_ptr<Field>>& a,
+                  const TypeMap<std::shared_ptr<Field>>& b,
+                  std::shared_ptr<State> state)
+    {
+    double value = 0.;
+    for (const auto& t : state->getTypes())
+        {
+        auto a_t = a(t)->const_view();
+        auto b_t = b(t)->const_view();
+        const int shape = a_t.size();
+        double type_value = 0.;
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(shape) shared(a_t, b_t) \
+    reduction(+ : type_value)
+#endif
+        for (int idx = 0; idx < shape; ++idx)
+            {
+            type_value += a_t(idx) * b_t(idx);
+            }
+        value += type_value;
+        }
+    return state->getCommunicator()->sum(value);
+    }
+
+//! Global maximum absolute value of a set of fields on the interior points
+static double maxNorm(const TypeMap<std::shared_ptr<Field>>& a, std::shared_ptr<State> state)
+    {
+    double value = 0.;
+    for (const auto& t : state->getTypes())
+        {
+        auto a_t = a(t)->const_view();
+        const int shape = a_t.size();
+        double type_value = 0.;
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(shape) shared(a_t) \
+    reduction(max : type_value)
+#endif
+        for (int idx = 0; idx < shape; ++idx)
+            {
+            const double x = std::abs(a_t(idx));
+            if (x > type_value)
+                {
+                type_value = x;
+                }
+            }
+        value = std::max(value, type_value);
+        }
+    return state->getCommunicator()->max(value);
+    }
+
+ImplicitIntegrator::ImplicitIntegrator(double timestep,
+                                       double mix_param,
+                                       int max_iterations,
+                                       double tolerance)
+    : Integrator(timestep), FixedPointAlgorithmMixin(mix_param, max_iterations, tolerance),
+      method_(Method::fixed_point), krylov_dimension_(20), krylov_tolerance_(1e-3)
+    {
+    }
+
+bool ImplicitIntegrator::advance(std::shared_ptr<Flux> flux,
+                                 std::shared_ptr<GrandPotential> grand,
+                                 std::shared_ptr<State> state,
+                                 double time)
+    {
+    state->matchFields(explicit_fields_);
+    return Integrator::advance(flux, grand, state, time);
+    }
+
+ImplicitIntegrator::Method ImplicitIntegrator::getMethod() const
+    {
+    return method_;
+    }
+
+void ImplicitIntegrator::setMethod(Method method)
+    {
+    method_ = method;
+    }
+
+int ImplicitIntegrator::getKrylovDimension() const
+    {
+    return krylov_dimension_;
+    }
+
+void ImplicitIntegrator::setKrylovDimension(int dimension)
+    {
+    if (dimension < 1)
+        {
+        throw std::invalid_argument("Krylov dimension must be at least 1");
+        }
+    krylov_dimension_ = dimension;
+    }
+
+double ImplicitIntegrator::getKrylovTolerance() const
+    {
+    return krylov_tolerance_;
+    }
+
+void ImplicitIntegrator::setKrylovTolerance(double tolerance)
+    {
+    if (tolerance <= 0 || tolerance >= 1)
+        {
+        throw std::invalid_argument("Krylov tolerance must be between 0 and 1");
+        }
+    krylov_tolerance_ = tolerance;
+    }
+
+bool ImplicitIntegrator::solve(std::shared_ptr<Flux> flux,
+                               std::shared_ptr<GrandPotential> grand,
+                               std::shared_ptr<State> state,
+                               const TypeMap<std::shared_ptr<Field>>& explicit_fields,
+                               double implicit_timestep)
+    {
+    if (method_ == Method::newton_krylov)
+        {
+        return solveNewtonKrylov(flux, grand, state, explicit_fields, implicit_timestep);
+        }
+    else
+        {
+        return solveFixedPoint(flux, grand, state, explicit_fields, implicit_timestep);
+        }
+    }
+
+bool ImplicitIntegrator::solveFixedPoint(std::shared_ptr<Flux> flux,
+                                         std::shared_ptr<GrandPotential> grand,
+                                         std::shared_ptr<State> state,
+                                         const TypeMap<std::shared_ptr<Field>>& explicit_fields,
+                                         double implicit_timestep)
+    {
+    const auto mesh = state->getMesh()->local().get();
+    const auto inv_volumes = mesh->inverse_volumes();
+    const auto alpha = mix_param_;
+    const auto tol = tolerance_;
+    bool converged = false;
+    for (int iter = 0; iter < max_iterations_ && !converged; ++iter)
+        {
+        // propose converged, and invalidate if any change is too big
+        converged = true;
+
+        // get flux of the new state
+        flux->compute(grand, state);
+
+        // apply update
+        for (const auto& t : state->getTypes())
+            {
+            auto explicit_rho = explicit_fields(t)->const_view();
+            auto next_rho = state->getField(t)->view();
+            auto next_j = flux->getFlux(t)->const_view();
+
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) \
+    firstprivate(implicit_timestep, mesh, inv_volumes, alpha, tol) \
+    shared(next_rho, next_j, explicit_rho, converged)
+#endif
+            for (int idx = 0; idx < mesh->shape(); ++idx)
+                {
+                const double next_rate = mesh->integrateSurface(idx, next_j) * inv_volumes[idx];
+                const double try_rho = explicit_rho(idx) + implicit_timestep * next_rate;
+                const double drho = alpha * (try_rho - next_rho(idx));
+                next_rho(idx) += drho;
+                if (std::abs(drho) > tol)
+                    {
+                    converged = false;
+                    }
+                }
+            }
+
+        converged = state->getCommunicator()->all(converged);
+        }
+    return converged;
+    }
+
+bool ImplicitIntegrator::solveNewtonKrylov(std::shared_ptr<Flux> flux,
+                                           std::shared_ptr<GrandPotential> grand,
+                                           std::shared_ptr<State> state,
+                                           const TypeMap<std::shared_ptr<Field>>& explicit_fields,
+                                           double implicit_timestep)
+    {
+    // trial state shares the time of the state, so only its densities change
+    if (!trial_state_)
+        {
+        trial_state_ = std::make_shared<State>(*state);
+        }
+    else
+        {
+        *trial_state_ = *state;
+        }
+    state->matchFields(residual_);
+    state->matchFields(trial_residual_);
+    krylov_basis_.resize(krylov_dimension_ + 1);
+    for (auto& v : krylov_basis_)
+        {
+        state->matchFields(v);
+        }
+
+    const int m = krylov_dimension_;
+    std::vector<std::vector<double>> H(m + 1, std::vector<double>(m, 0.));
+    std::vector<double> cs(m);
+    std::vector<double> sn(m);
+    std::vector<double> g(m + 1);
+    std::vector<double> y(m);
+    const double sqrt_eps = std::sqrt(std::numeric_limits<double>::epsilon());
+    for (int iter = 0; iter < max_iterations_; ++iter)
+        {
+        computeResidual(flux, grand, state, explicit_fields, implicit_timestep, residual_);
+        if (maxNorm(residual_, state) <= tolerance_)
+            {
+            return true;
+            }
+
+        // first basis vector is the normalized negative residual
+        const double beta = std::sqrt(dot(residual_, residual_, state));
+        for (const auto& t : state->getTypes())
+            {
+            assign(krylov_basis_[0](t)->view(), (-1. / beta) * residual_(t)->const_view());
+            }
+        std::fill(g.begin(), g.end(), 0.);
+        g[0] = beta;
+
+        // finite difference step scales with the size of the densities, basis vectors are unit
+        const double eps
+            = sqrt_eps * (1. + std::sqrt(dot(state->getFields(), state->getFields(), state)));
+
+        // GMRES by Arnoldi iteration with Givens rotations, starting from a zero step
+        int num_basis = 0;
+        for (int k = 0; k < m; ++k)
+            {
+            for (const auto& t : state->getTypes())
+                {
+                assign(trial_state_->getField(t)->view(),
+                       state->getField(t)->const_view()
+                           + eps * krylov_basis_[k](t)->const_view());
+                }
+            computeResidual(flux,
+                            grand,
+                            trial_state_,
+                            explicit_fields,
+                            implicit_timestep,
+                            trial_residual_);
+            auto& w = krylov_basis_[k + 1];
+            for (const auto& t : state->getTypes())
+                {
+                assign(w(t)->view(),
+                       (trial_residual_(t)->const_view() - residual_(t)->const_view())
+                           * (1. / eps));
+                }
+
+            // orthogonalize against the basis by modified Gram-Schmidt
+            for (int i = 0; i <= k; ++i)
+                {
+                H[i][k] = dot(w, krylov_basis_[i], state);
+                for (const auto& t : state->getTypes())
+                    {
+                    auto w_t = w(t)->view();
+                    assign(w_t, w_t - H[i][k] * krylov_basis_[i](t)->const_view());
+                    }
+                }
+            H[k + 1][k] = std::sqrt(dot(w, w, state));
+            // nothing is left of w at a breakdown, so the basis spans an invariant subspace
+            const bool breakdown = !(H[k + 1][k] > 0);
+            if (!breakdown)
+                {
+                for (const auto& t : state->getTypes())
+                    {
+                    auto w_t = w(t)->view();
+                    assign(w_t, w_t * (1. / H[k + 1][k]));
+                    }
+                }
+
+            // apply previous rotations to the new column, then rotate away the subdiagonal
+            for (int i = 0; i < k; ++i)
+                {
+                const double h = cs[i] * H[i][k] + sn[i] * H[i + 1][k];
+                H[i + 1][k] = -sn[i] * H[i][k] + cs[i] * H[i + 1][k];
+                H[i][k] = h;
+                }
+            const double r = std::sqrt(H[k][k] * H[k][k] + H[k + 1][k] * H[k + 1][k]);
+            if (!(r > 0))
+                {
+                // the new column vanished, so it cannot be rotated and the least-squares system
+                // is solved with the basis built so far
+                break;
+                }
+            cs[k] = H[k][k] / r;
+            sn[k] = H[k + 1][k] / r;
+            H[k][k] = r;
+            H[k + 1][k] = 0.;
+            g[k + 1] = -sn[k] * g[k];
+            g[k] *= cs[k];
+            ++num_basis;
+
+            if (breakdown || std::abs(g[k + 1]) <= krylov_tolerance_ * beta)
+                {
+                break;
+                }
+            }
+        if (num_basis == 0)
+            {
+            // the Jacobian maps the residual to zero, so there is no Newton step to take
+            break;
+            }
+
+        // solve the triangular least-squares system and take the Newton step
+        for (int i = num_basis - 1; i >= 0; --i)
+            {
+            double value = g[i];
+            for (int j = i + 1; j < num_basis; ++j)
+                {
+                value -= H[i][j] * y[j];
+                }
+            y[i] = value / H[i][i];
+            }
+        for (int i = 0; i < num_basis; ++i)
+            {
+            for (const auto& t : state->getTypes())
+                {
+                auto rho = state->getField(t)->view();
+                assign(rho, rho + y[i] * krylov_basis_[i](t)->const_view());
+                }
+            }
+        }
+
+    computeResidual(flux, grand, state, explicit_fields, implicit_timestep, residual_);
+    return (maxNorm(residual_, state) <= tolerance_);
+    }
+
+void ImplicitIntegrator::computeResidual(std::shared_ptr<Flux> flux,
+                                         std::shared_ptr<GrandPotential> grand,
+                                         std::shared_ptr<State> state,
+                                         const TypeMap<std::shared_ptr<Field>>& explicit_fields,
+                                         double implicit_timestep,
+                                         TypeMap<std::shared_ptr<Field>>& residual)
+    {
+    const auto mesh = state->getMesh()->local().get();
+    flux->compute(grand, state);
+    for (const auto& t : state->getTypes())
+        {
+        auto j = flux->getFlux(t)->const_view();
+        assign(residual(t)->view(),
+               state->getField(t)->const_view() - explicit_fields(t)->const_view()
+                   - implicit_timestep * (integrateSurface(mesh, j) * inverseVolume(mesh)));
+        }
+    }
+
+    } // namespace flyft
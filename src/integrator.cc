@@ -56,8 +56,8 @@ bool Integrator::advance(std::shared_ptr<Flux> flux,
             adaptive_last_remain = time_remain;
             const auto mesh = state->getMesh()->local().get();
 
-            *adaptive_cur_state_ = *state;
-
+            // trial steps are taken into the adaptive states, so the state is only replaced
+            // once a step is accepted and rejected steps need no rollback
             double dt_try = timestep_;
             double dt_next = timestep_;
             bool converged = false;
@@ -68,19 +68,18 @@ bool Integrator::advance(std::shared_ptr<Flux> flux,
                     throw std::runtime_error("timestep decreased too much");
                     }
 
-                // take two normal steps
-                step(flux, grand, state, time_sign * dt_try);
-                step(flux, grand, state, time_sign * dt_try);
+                // take double-sized step
+                stepInto(flux, grand, state, adaptive_err_state_, 2 * time_sign * dt_try);
 
-                // then take double-sized step
-                *adaptive_err_state_ = *adaptive_cur_state_;
-                step(flux, grand, adaptive_err_state_, 2 * time_sign * dt_try);
+                // then take two normal steps, where the first reuses the flux of the state
+                stepInto(flux, grand, state, adaptive_cur_state_, time_sign * dt_try);
+                step(flux, grand, adaptive_cur_state_, time_sign * dt_try);
 
                 // compute error between the two
                 double max_err = 0.;
                 for (const auto& t : state->getTypes())
                     {
-                    auto rho = state->getField(t)->const_view();
+                    auto rho = adaptive_cur_state_->getField(t)->const_view();
                     auto rho_err = adaptive_err_state_->getField(t)->const_view();
                     // find max error on mesh
                     double type_max_err = 0.;
@@ -113,7 +112,6 @@ bool Integrator::advance(std::shared_ptr<Flux> flux,
                                            * std::pow(adaptive_timestep_tol_ / max_err,
                                                       1. / getLocalErrorExponent()),
                                        0.1);
-                    *state = *adaptive_cur_state_;
                     }
                 else
                     {
@@ -131,6 +129,7 @@ bool Integrator::advance(std::shared_ptr<Flux> flux,
                         {
                         dt_next = 5. * dt_try;
                         }
+                    state->swap(*adaptive_cur_state_);
                     }
                 }
 
@@ -217,6 +216,16 @@ void Integrator::enableAdaptiveTimestep(bool enable)
     use_adaptive_timestep_ = enable;
     }
 
+void Integrator::stepInto(std::shared_ptr<Flux> flux,
+                          std::shared_ptr<GrandPotential> grand,
+                          std::shared_ptr<State> state,
+                          std::shared_ptr<State> next_state,
+                          double timestep)
+    {
+    *next_state = *state;
+    step(flux, grand, next_state, timestep);
+    }
+
 int Integrator::determineBufferShape(std::shared_ptr<State> /*state*/, const std::string& /*type*/)
     {
     return 1;
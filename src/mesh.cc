@@ -1,6 +1,7 @@
 #include "flyft/mesh.h"
 
 #include <cmath>
+#include <stdexcept>
 
 namespace flyft
     {
@@ -34,9 +35,69 @@ std::shared_ptr<Mesh> Mesh::slice(int start, int end) const
         {
         m->upper_bc_ = BoundaryType::internal;
         }
+    m->setupGeometry();
     return m;
     }
 
+std::shared_ptr<Mesh> Mesh::coarsen(int shape) const
+    {
+    if (lower_bc_ == BoundaryType::internal || upper_bc_ == BoundaryType::internal)
+        {
+        throw std::runtime_error("Cannot coarsen a sliced Mesh.");
+        }
+    if (shape < 1)
+        {
+        throw std::invalid_argument("Mesh shape must be positive");
+        }
+
+    auto m = clone();
+    m->resample(shape);
+    m->setupGeometry();
+    return m;
+    }
+
+void Mesh::resample(int shape)
+    {
+    step_ = L() / shape;
+    shape_ = shape;
+    }
+
+void Mesh::setupGeometry()
+    {
+    centers_.resize(shape_);
+    areas_.resize(shape_ + 1);
+    volumes_.resize(shape_);
+    inverse_volumes_.resize(shape_);
+    for (int i = 0; i < shape_; ++i)
+        {
+        centers_[i] = center(i);
+        areas_[i] = area(i);
+        volumes_[i] = volume(i);
+        inverse_volumes_[i] = 1. / volumes_[i];
+        }
+    areas_[shape_] = area(shape_);
+    }
+
+const double* Mesh::centers() const
+    {
+    return centers_.data();
+    }
+
+const double* Mesh::areas() const
+    {
+    return areas_.data();
+    }
+
+const double* Mesh::volumes() const
+    {
+    return volumes_.data();
+    }
+
+const double* Mesh::inverse_volumes() const
+    {
+    return inverse_volumes_.data();
+    }
+
 double Mesh::center(int i) const
     {
     return lower_ + static_cast<double>(start_ + i + 0.5) * step_;
@@ -44,7 +105,8 @@ double Mesh::center(int i) const
 
 int Mesh::bin(double x) const
     {
-    return static_cast<int>((x - lower_) / step_) - start_;
+    // round down so that positions below the mesh fall in the buffer bins
+    return static_cast<int>(std::floor((x - lower_) / step_)) - start_;
     }
 
 double Mesh::lower_bound() const
@@ -94,38 +156,51 @@ double Mesh::asLength(int shape) const
 
 double Mesh::integrateSurface(int idx, double j_lo, double j_hi) const
     {
-    return area(idx) * j_lo - area(idx + 1) * j_hi;
+    if (idx >= 0 && idx < static_cast<int>(volumes_.size()))
+        {
+        return areas_[idx] * j_lo - areas_[idx + 1] * j_hi;
+        }
+    else
+        {
+        return area(idx) * j_lo - area(idx + 1) * j_hi;
+        }
     }
 
-double Mesh::integrateSurface(int idx, const DataView<double>& j) const
+double Mesh::integrateSurface(int idx, const DataView<FieldValue>& j) const
     {
     return integrateSurface(idx, j(idx), j(idx + 1));
     }
 
-double Mesh::integrateSurface(int idx, const DataView<const double>& j) const
+double Mesh::integrateSurface(int idx, const DataView<const FieldValue>& j) const
     {
     return integrateSurface(idx, j(idx), j(idx + 1));
     }
 
 double Mesh::integrateVolume(int idx, double f) const
     {
-    return volume(idx) * f;
+    if (idx >= 0 && idx < static_cast<int>(volumes_.size()))
+        {
+        return volumes_[idx] * f;
+        }
+    else
+        {
+        return volume(idx) * f;
+        }
     }
 
-double Mesh::integrateVolume(int idx, const DataView<double>& f) const
+double Mesh::integrateVolume(int idx, const DataView<FieldValue>& f) const
     {
     return integrateVolume(idx, f(idx));
     }
 
-double Mesh::integrateVolume(int idx, const DataView<const double>& f) const
+double Mesh::integrateVolume(int idx, const DataView<const FieldValue>& f) const
     {
     return integrateVolume(idx, f(idx));
     }
 
-double Mesh::gradient(int idx, const DataView<double>& f) const
+double Mesh::gradient(int idx, const DataView<FieldValue>& f) const
     {
-    if ((idx == 0 && lower_bc_ == BoundaryType::reflect)
-        || (idx == shape_ - 1 && upper_bc_ == BoundaryType::reflect))
+    if (isReflectingEdge(idx))
         {
         return 0;
         }
@@ -135,10 +210,9 @@ double Mesh::gradient(int idx, const DataView<double>& f) const
         }
     }
 
-double Mesh::gradient(int idx, const DataView<const double>& f) const
+double Mesh::gradient(int idx, const DataView<const FieldValue>& f) const
     {
-    if ((idx == 0 && lower_bc_ == BoundaryType::reflect)
-        || (idx == shape_ - 1 && upper_bc_ == BoundaryType::reflect))
+    if (isReflectingEdge(idx))
         {
         return 0;
         }
@@ -152,7 +226,12 @@ bool Mesh::operator==(const Mesh& other) const
     {
     return (typeid(*this) == typeid(other) && lower_ == other.lower_ && shape_ == other.shape_
             && lower_bc_ == other.lower_bc_ && upper_bc_ == other.upper_bc_
-            && start_ == other.start_);
+            && start_ == other.start_ && sameGeometry(other));
+    }
+
+bool Mesh::sameGeometry(const Mesh& other) const
+    {
+    return (step_ == other.step_);
     }
 
 bool Mesh::operator!=(const Mesh& other) const
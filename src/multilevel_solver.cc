@@ -0,0 +1,177 @@
+#include "flyft/multilevel_solver.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace flyft
+    {
+
+MultilevelSolver::MultilevelSolver(std::shared_ptr<Solver> solver, int num_levels, int min_shape)
+    {
+    setSolver(solver);
+    setNumLevels(num_levels);
+    setMinShape(min_shape);
+    }
+
+bool MultilevelSolver::solve(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state)
+    {
+    setupLevels(state);
+    if (!levels_.empty())
+        {
+        // solve from the coarsest level up, seeding each finer level with the solution
+        restrictFields(state, levels_.front());
+        for (int level = 0; level < static_cast<int>(levels_.size()); ++level)
+            {
+            auto coarse = levels_[level];
+            auto fine = (level + 1 < static_cast<int>(levels_.size())) ? levels_[level + 1] : state;
+            coarse->setTime(state->getTime());
+            solver_->solve(grand, coarse);
+            prolongFields(coarse, fine);
+            }
+        }
+    return solver_->solve(grand, state);
+    }
+
+std::shared_ptr<Solver> MultilevelSolver::getSolver()
+    {
+    return solver_;
+    }
+
+void MultilevelSolver::setSolver(std::shared_ptr<Solver> solver)
+    {
+    if (!solver)
+        {
+        throw std::invalid_argument("Multilevel solver needs a solver");
+        }
+    solver_ = solver;
+    }
+
+int MultilevelSolver::getNumLevels() const
+    {
+    return num_levels_;
+    }
+
+void MultilevelSolver::setNumLevels(int num_levels)
+    {
+    if (num_levels < 1)
+        {
+        throw std::invalid_argument("Number of levels must be at least 1");
+        }
+    num_levels_ = num_levels;
+    mesh_.reset();
+    }
+
+int MultilevelSolver::getMinShape() const
+    {
+    return min_shape_;
+    }
+
+void MultilevelSolver::setMinShape(int min_shape)
+    {
+    if (min_shape < 1)
+        {
+        throw std::invalid_argument("Minimum shape must be at least 1");
+        }
+    min_shape_ = min_shape;
+    mesh_.reset();
+    }
+
+void MultilevelSolver::setupLevels(std::shared_ptr<State> state)
+    {
+    auto mesh = state->getMesh();
+    if (mesh_ && mesh == mesh_ && state->getTypes() == types_)
+        {
+        return;
+        }
+    mesh_ = mesh;
+    types_ = state->getTypes();
+    levels_.clear();
+
+    // coarse levels are small, so every rank keeps a whole copy
+#ifdef FLYFT_MPI
+    auto comm = std::make_shared<Communicator>(MPI_COMM_SELF, 0);
+#else
+    auto comm = std::make_shared<Communicator>();
+#endif // FLYFT_MPI
+    const auto full_mesh = mesh->full();
+    int shape = full_mesh->shape();
+    for (int level = 1; level < num_levels_; ++level)
+        {
+        shape /= 2;
+        if (shape < min_shape_)
+            {
+            break;
+            }
+        auto coarse_mesh = std::make_shared<ParallelMesh>(full_mesh->coarsen(shape), comm);
+        auto coarse = std::make_shared<State>(coarse_mesh, types_);
+        for (const auto& t : types_)
+            {
+            // interpolation reads one point past each edge
+            coarse->requestFieldBuffer(t, 1);
+            }
+        levels_.insert(levels_.begin(), coarse);
+        }
+    }
+
+void MultilevelSolver::restrictFields(std::shared_ptr<State> fine, std::shared_ptr<State> coarse)
+    {
+    const auto fine_mesh = fine->getMesh()->local().get();
+    const auto coarse_mesh = coarse->getMesh()->local().get();
+    const auto volumes = fine_mesh->volumes();
+    const int coarse_shape = coarse_mesh->shape();
+    auto comm = fine->getCommunicator();
+    for (const auto& t : fine->getTypes())
+        {
+        // volume-weighted sums of the fine points whose centers are in each coarse bin
+        std::vector<double> sums(2 * coarse_shape, 0.);
+        auto rho = fine->getField(t)->const_view();
+        for (int idx = 0; idx < fine_mesh->shape(); ++idx)
+            {
+            const int bin = coarse_mesh->bin(fine_mesh->center(idx));
+            sums[bin] += volumes[idx] * rho(idx);
+            sums[coarse_shape + bin] += volumes[idx];
+            }
+        if (comm->size() > 1)
+            {
+            const auto all_sums = comm->allgather(sums);
+            std::fill(sums.begin(), sums.end(), 0.);
+            for (int rank = 0; rank < comm->size(); ++rank)
+                {
+                for (int idx = 0; idx < 2 * coarse_shape; ++idx)
+                    {
+                    sums[idx] += all_sums[rank * 2 * coarse_shape + idx];
+                    }
+                }
+            }
+
+        auto coarse_rho = coarse->getField(t)->view();
+        for (int idx = 0; idx < coarse_shape; ++idx)
+            {
+            const double volume = sums[coarse_shape + idx];
+            coarse_rho(idx) = (volume > 0) ? sums[idx] / volume : 0.;
+            }
+        }
+    }
+
+void MultilevelSolver::prolongFields(std::shared_ptr<State> coarse, std::shared_ptr<State> fine)
+    {
+    const auto coarse_mesh = coarse->getMesh()->local().get();
+    const auto fine_mesh = fine->getMesh()->local().get();
+    coarse->syncFields();
+    for (const auto& t : fine->getTypes())
+        {
+        auto coarse_rho = coarse->getField(t)->const_view();
+        auto rho = fine->getField(t)->view();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(coarse_mesh, fine_mesh) \
+    shared(coarse_rho, rho)
+#endif
+        for (int idx = 0; idx < fine_mesh->shape(); ++idx)
+            {
+            rho(idx) = coarse_mesh->interpolate(fine_mesh->center(idx), coarse_rho);
+            }
+        }
+    }
+
+    } // namespace flyft
@@ -0,0 +1,181 @@
+#include "flyft/nonuniform_cartesian_mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace flyft
+    {
+
+NonuniformCartesianMesh::NonuniformCartesianMesh(const std::vector<double>& edges,
+                                                 BoundaryType lower_bc,
+                                                 BoundaryType upper_bc,
+                                                 double area)
+    : Mesh((edges.empty()) ? 0. : edges.front(),
+           (edges.empty()) ? 0. : edges.back(),
+           static_cast<int>(edges.size()) - 1,
+           lower_bc,
+           upper_bc),
+      edges_(edges), area_(area), periodic_(lower_bc == BoundaryType::periodic)
+    {
+    if (edges_.size() < 2)
+        {
+        throw std::invalid_argument("Mesh needs at least 2 edges");
+        }
+    for (size_t i = 1; i < edges_.size(); ++i)
+        {
+        if (!(edges_[i] > edges_[i - 1]))
+            {
+            throw std::invalid_argument("Mesh edges must be increasing");
+            }
+        }
+    setupStep();
+    setupGeometry();
+    }
+
+double NonuniformCartesianMesh::lower_bound(int i) const
+    {
+    return edge(start_ + i);
+    }
+
+double NonuniformCartesianMesh::center(int i) const
+    {
+    return 0.5 * (lower_bound(i) + lower_bound(i + 1));
+    }
+
+int NonuniformCartesianMesh::bin(double x) const
+    {
+    const int num_bins = static_cast<int>(edges_.size()) - 1;
+    const double length = edges_[num_bins] - edges_[0];
+    auto find_bin = [&](double y)
+    {
+        const int idx
+            = static_cast<int>(std::upper_bound(edges_.begin(), edges_.end(), y) - edges_.begin())
+              - 1;
+        return std::min(std::max(idx, 0), num_bins - 1);
+    };
+
+    // wrap or mirror the position into the mesh to find the bin in the same way as the edges
+    int idx;
+    if (periodic_)
+        {
+        const int image = static_cast<int>(std::floor((x - edges_[0]) / length));
+        idx = image * num_bins + find_bin(x - image * length);
+        }
+    else
+        {
+        // the mesh and its mirror image repeat every two lengths
+        const int image = static_cast<int>(std::floor((x - edges_[0]) / (2. * length)));
+        const double y = x - 2. * image * length;
+        if (y < edges_[num_bins])
+            {
+            idx = find_bin(y);
+            }
+        else
+            {
+            idx = 2 * num_bins - 1 - find_bin(2. * edges_[num_bins] - y);
+            }
+        idx += 2 * image * num_bins;
+        }
+
+    // rounding when the position is moved can put it one bin off, so check it against the edges
+    while (x < edge(idx))
+        {
+        --idx;
+        }
+    while (x >= edge(idx + 1))
+        {
+        ++idx;
+        }
+    return idx - start_;
+    }
+
+double NonuniformCartesianMesh::L() const
+    {
+    return lower_bound(shape_) - lower_bound(0);
+    }
+
+double NonuniformCartesianMesh::area(int /*i*/) const
+    {
+    return area_;
+    }
+
+double NonuniformCartesianMesh::volume() const
+    {
+    return area_ * L();
+    }
+
+double NonuniformCartesianMesh::volume(int i) const
+    {
+    return area_ * (lower_bound(i + 1) - lower_bound(i));
+    }
+
+double NonuniformCartesianMesh::gradient(int idx, double f_lo, double f_hi) const
+    {
+    return (f_hi - f_lo) / (center(idx) - center(idx - 1));
+    }
+
+const std::vector<double>& NonuniformCartesianMesh::edges() const
+    {
+    return edges_;
+    }
+
+std::shared_ptr<Mesh> NonuniformCartesianMesh::clone() const
+    {
+    return std::make_shared<NonuniformCartesianMesh>(*this);
+    }
+
+void NonuniformCartesianMesh::resample(int shape)
+    {
+    // place the new edges at evenly spaced fractional indexes of the old ones to keep the grading
+    const int num_bins = static_cast<int>(edges_.size()) - 1;
+    std::vector<double> edges(shape + 1);
+    for (int i = 0; i <= shape; ++i)
+        {
+        const double x = static_cast<double>(i) * num_bins / shape;
+        const int j = std::min(static_cast<int>(x), num_bins - 1);
+        edges[i] = edges_[j] + (x - j) * (edges_[j + 1] - edges_[j]);
+        }
+    edges[shape] = edges_[num_bins];
+    edges_ = edges;
+    shape_ = shape;
+    setupStep();
+    }
+
+bool NonuniformCartesianMesh::sameGeometry(const Mesh& other) const
+    {
+    auto other_mesh = dynamic_cast<const NonuniformCartesianMesh*>(&other);
+    return (other_mesh != nullptr && edges_ == other_mesh->edges_);
+    }
+
+double NonuniformCartesianMesh::edge(int idx) const
+    {
+    const int num_bins = static_cast<int>(edges_.size()) - 1;
+    if (idx < 0)
+        {
+        // edges below the mesh wrap around or mirror the first edges
+        return (periodic_) ? edge(idx + num_bins) - (edges_[num_bins] - edges_[0])
+                           : 2. * edges_[0] - edge(-idx);
+        }
+    else if (idx > num_bins)
+        {
+        // edges above the mesh wrap around or mirror the last edges
+        return (periodic_) ? edge(idx - num_bins) + (edges_[num_bins] - edges_[0])
+                           : 2. * edges_[num_bins] - edge(2 * num_bins - idx);
+        }
+    else
+        {
+        return edges_[idx];
+        }
+    }
+
+void NonuniformCartesianMesh::setupStep()
+    {
+    step_ = edges_[1] - edges_[0];
+    for (size_t i = 2; i < edges_.size(); ++i)
+        {
+        step_ = std::min(step_, edges_[i] - edges_[i - 1]);
+        }
+    }
+
+    } // namespace flyft
@@ -121,10 +121,13 @@ void ParallelMesh::sync(std::shared_ptr<Field> field)
 void ParallelMesh::startSync(std::shared_ptr<Field> field)
     {
     // check if field was recently synced and stop if not needed
-    auto token = field_tokens_.find(field->id());
-    if (token != field_tokens_.end() && token->second == field->token())
         {
-        return;
+        std::lock_guard<std::mutex> lock(field_tokens_mutex_);
+        auto token = field_tokens_.find(field->id());
+        if (token != field_tokens_.end() && token->second == field->token())
+            {
+            return;
+            }
         }
 
 // make sure field is not currently in flight before we do anything
@@ -156,6 +159,7 @@ void ParallelMesh::startSync(std::shared_ptr<Field> field)
 #ifdef FLYFT_MPI
     const int left = layout_(getProcessorCoordinatesByOffset(-1));
     const int right = layout_(getProcessorCoordinatesByOffset(1));
+    const MPI_Datatype value_type = comm_->mpi_type<FieldValue>();
     std::vector<MPI_Request> requests;
     requests.reserve(4);
 
@@ -166,8 +170,8 @@ void ParallelMesh::startSync(std::shared_ptr<Field> field)
         MPI_Comm comm = comm_->get();
         const auto end = requests.size();
         requests.resize(end + 2);
-        MPI_Irecv(&f(-buffer_shape), buffer_shape, MPI_DOUBLE, left, 0, comm, &requests[end]);
-        MPI_Isend(&f(0), buffer_shape, MPI_DOUBLE, left, 1, comm, &requests[end + 1]);
+        MPI_Irecv(&f(-buffer_shape), buffer_shape, value_type, left, 0, comm, &requests[end]);
+        MPI_Isend(&f(0), buffer_shape, value_type, left, 1, comm, &requests[end + 1]);
         }
     else
 #endif
@@ -207,10 +211,10 @@ void ParallelMesh::startSync(std::shared_ptr<Field> field)
         MPI_Comm comm = comm_->get();
         const auto end = requests.size();
         requests.resize(end + 2);
-        MPI_Irecv(&f(shape), buffer_shape, MPI_DOUBLE, right, 1, comm, &requests[end]);
+        MPI_Irecv(&f(shape), buffer_shape, value_type, right, 1, comm, &requests[end]);
         MPI_Isend(&f(shape - buffer_shape),
                   buffer_shape,
-                  MPI_DOUBLE,
+                  value_type,
                   right,
                   0,
                   comm,
@@ -253,6 +257,7 @@ void ParallelMesh::startSync(std::shared_ptr<Field> field)
         }
 #endif
     // cache token
+    std::lock_guard<std::mutex> lock(field_tokens_mutex_);
     field_tokens_[field->id()] = field->token();
     }
 
@@ -319,13 +324,14 @@ std::shared_ptr<Field> ParallelMesh::gather(std::shared_ptr<Field> field, int /*
             }
 
         // gather to the root rank
+        const MPI_Datatype value_type = comm_->mpi_type<FieldValue>();
         MPI_Gatherv(&f(0),
                     f.size(),
-                    MPI_DOUBLE,
+                    value_type,
                     recv,
                     &counts[0],
                     &starts_[0],
-                    MPI_DOUBLE,
+                    value_type,
                     root,
                     comm_->get());
         }
@@ -1,6 +1,8 @@
 #include "flyft/picard_iteration.h"
 
+#include <algorithm>
 #include <cmath>
+#include <tuple>
 
 namespace flyft
     {
@@ -38,7 +40,20 @@ bool PicardIteration::solve(std::shared_ptr<GrandPotential> grand, std::shared_p
             Field tmp(state->getField(t)->shape(), state->getField(t)->buffer_shape());
             auto rho_tmp = tmp.view();
             auto mu_ex = (excess) ? excess->getDerivative(t)->const_view() : Field::ConstantView();
-            auto V = (external) ? external->getDerivative(t)->const_view() : Field::ConstantView();
+            // the external potential only enters through its cached Boltzmann factor
+            auto boltzmann_V = (external) ? external->getBoltzmannFactor(t)->const_view()
+                                          : Field::ConstantView();
+
+            // the density vanishes where the potential is infinite, so only the active range needs
+            // to be evaluated
+            int first = 0;
+            int last = mesh->shape();
+            if (external)
+                {
+                std::tie(first, last) = external->getActiveRange(t);
+                }
+            std::fill(rho_tmp.begin(), rho_tmp.begin() + first, 0.);
+            std::fill(rho_tmp.begin() + last, rho_tmp.end(), 0.);
 
             double norm = 1.0;
             auto constraint_type = grand->getConstraintTypes()(t);
@@ -47,21 +62,17 @@ bool PicardIteration::solve(std::shared_ptr<GrandPotential> grand, std::shared_p
                 auto N = grand->getConstraints()(t);
                 double sum = 0.0;
 #ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(mesh) \
-    shared(mu_ex, V, rho_tmp) reduction(+ : sum)
+#pragma omp parallel for schedule(static) default(none) firstprivate(mesh, first, last) \
+    shared(mu_ex, boltzmann_V, rho_tmp) reduction(+ : sum)
 #endif
-                for (int idx = 0; idx < mesh->shape(); ++idx)
+                for (int idx = first; idx < last; ++idx)
                     {
-                    double eff_energy = 0.0;
-                    if (mu_ex)
+                    double boltzmann = (mu_ex) ? std::exp(-mu_ex(idx)) : 1.0;
+                    if (boltzmann_V)
                         {
-                        eff_energy += mu_ex(idx);
+                        boltzmann *= boltzmann_V(idx);
                         }
-                    if (V)
-                        {
-                        eff_energy += V(idx);
-                        }
-                    rho_tmp(idx) = std::exp(-eff_energy);
+                    rho_tmp(idx) = boltzmann;
                     sum += mesh->integrateVolume(idx, rho_tmp);
                     }
                 sum = state->getCommunicator()->sum(sum);
@@ -71,21 +82,18 @@ bool PicardIteration::solve(std::shared_ptr<GrandPotential> grand, std::shared_p
                 {
                 const auto mu_bulk = grand->getConstraints()(t);
 #ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(mesh, mu_bulk) \
-    shared(mu_ex, V, rho_tmp)
+#pragma omp parallel for schedule(static) default(none) \
+    firstprivate(mesh, mu_bulk, first, last) shared(mu_ex, boltzmann_V, rho_tmp)
 #endif
-                for (int idx = 0; idx < mesh->shape(); ++idx)
+                for (int idx = first; idx < last; ++idx)
                     {
-                    double eff_energy = 0.0;
-                    if (mu_ex)
-                        {
-                        eff_energy += mu_ex(idx);
-                        }
-                    if (V)
+                    const double mu_eff = (mu_ex) ? mu_bulk - mu_ex(idx) : mu_bulk;
+                    double boltzmann = std::exp(mu_eff);
+                    if (boltzmann_V)
                         {
-                        eff_energy += V(idx);
+                        boltzmann *= boltzmann_V(idx);
                         }
-                    rho_tmp(idx) = std::exp(-eff_energy + mu_bulk);
+                    rho_tmp(idx) = boltzmann;
                     }
                 norm = 1.0 / ideal->getVolumes()(t);
                 }
@@ -11,7 +11,7 @@
 namespace flyft
     {
 
-RosenfeldFMT::RosenfeldFMT()
+RosenfeldFMT::RosenfeldFMT() : low_memory_(false)
     {
     compute_depends_.add(&diameters_);
     }
@@ -35,10 +35,18 @@ void RosenfeldFMT::_compute(std::shared_ptr<State> state, bool compute_value)
         {
         computeCartesianWeightedDensities(state);
         }
+    else if (conv_type == ConvolutionType::cartesian_cosine)
+        {
+        computeCartesianCosineWeightedDensities(state);
+        }
     else if (conv_type == ConvolutionType::spherical)
         {
         computeSphericalWeightedDensities(state);
         }
+    else if (conv_type == ConvolutionType::spherical_sine)
+        {
+        computeSphericalSineWeightedDensities(state);
+        }
     else
         {
         // TODO: throw error
@@ -60,8 +68,10 @@ void RosenfeldFMT::_compute(std::shared_ptr<State> state, bool compute_value)
         auto dphi_dn3 = dphi_dn3_->view();
         auto dphi_dnv1 = dphi_dnv1_->view();
         auto dphi_dnv2 = dphi_dnv2_->view();
+        const int lower_edge = std::min(buffer_shape_ + 1, mesh->shape() - buffer_shape_);
 
-            // do points near edges first and start sending them
+            // do points near edges first and start sending them, including the point that a
+            // reflecting lower boundary mirrors into the buffer
             {
 #ifdef FLYFT_OPENMP
 #pragma omp parallel for schedule(static) default(none) firstprivate(mesh) \
@@ -113,6 +123,24 @@ void RosenfeldFMT::_compute(std::shared_ptr<State> state, bool compute_value)
                                          nv2,
                                          compute_value);
                 }
+            for (int idx = buffer_shape_; idx < lower_edge; ++idx)
+                {
+                computePhiAndDerivatives(idx,
+                                         phi,
+                                         dphi_dn0,
+                                         dphi_dn1,
+                                         dphi_dn2,
+                                         dphi_dn3,
+                                         dphi_dnv1,
+                                         dphi_dnv2,
+                                         n0,
+                                         n1,
+                                         n2,
+                                         n3,
+                                         nv1,
+                                         nv2,
+                                         compute_value);
+                }
 
             auto comm = state->getMesh();
             comm->startSync(dphi_dn0_);
@@ -125,8 +153,8 @@ void RosenfeldFMT::_compute(std::shared_ptr<State> state, bool compute_value)
 
 // do all the inside points
 #ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(mesh) \
-    shared(n0,                                                             \
+#pragma omp parallel for schedule(static) default(none) firstprivate(mesh, lower_edge) \
+    shared(n0,                                                                         \
                n1,                                                         \
                n2,                                                         \
                n3,                                                         \
@@ -141,7 +169,7 @@ void RosenfeldFMT::_compute(std::shared_ptr<State> state, bool compute_value)
                dphi_dnv2,                                                  \
                compute_value)
 #endif
-        for (int idx = buffer_shape_; idx < mesh->shape() - buffer_shape_; ++idx)
+        for (int idx = lower_edge; idx < mesh->shape() - buffer_shape_; ++idx)
             {
             computePhiAndDerivatives(idx,
                                      phi,
@@ -176,10 +204,18 @@ void RosenfeldFMT::_compute(std::shared_ptr<State> state, bool compute_value)
         {
         computeCartesianDerivative(state);
         }
+    else if (conv_type == ConvolutionType::cartesian_cosine)
+        {
+        computeCartesianCosineDerivative(state);
+        }
     else if (conv_type == ConvolutionType::spherical)
         {
         computeSphericalDerivative(state);
         }
+    else if (conv_type == ConvolutionType::spherical_sine)
+        {
+        computeSphericalSineDerivative(state);
+        }
     else
         {
         // TODO: throw error
@@ -189,14 +225,16 @@ void RosenfeldFMT::_compute(std::shared_ptr<State> state, bool compute_value)
     if (compute_value)
         {
         auto phi = phi_->const_view();
+        const int shape = mesh->shape();
+        const double* volumes = mesh->volumes();
         value_ = 0.0;
 #ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(mesh) shared(phi) \
+#pragma omp parallel for schedule(static) default(none) firstprivate(shape, volumes) shared(phi) \
     reduction(+ : value_)
 #endif
-        for (int idx = 0; idx < mesh->shape(); ++idx)
+        for (int idx = 0; idx < shape; ++idx)
             {
-            value_ += mesh->integrateVolume(idx, phi);
+            value_ += volumes[idx] * phi(idx);
             }
         value_ = state->getCommunicator()->sum(value_);
         }
@@ -261,12 +299,13 @@ void RosenfeldFMT::computeCartesianWeightedDensities(std::shared_ptr<State> stat
             computeWeights(w2, w3, wv2, k, R);
             computeProportionalByWeight(w0, w1, wv1, w2, wv2, R);
 
-            n0k(idx) += w0 * rhok(idx);
-            n1k(idx) += w1 * rhok(idx);
-            n2k(idx) += w2 * rhok(idx);
-            n3k(idx) += w3 * rhok(idx);
-            nv1k(idx) += wv1 * rhok(idx);
-            nv2k(idx) += wv2 * rhok(idx);
+            const std::complex<double> rho = rhok(idx);
+            n0k(idx) += w0 * rho;
+            n1k(idx) += w1 * rho;
+            n2k(idx) += w2 * rho;
+            n3k(idx) += w3 * rho;
+            nv1k(idx) += wv1 * rho;
+            nv2k(idx) += wv2 * rho;
             }
         }
 
@@ -309,9 +348,122 @@ void RosenfeldFMT::computeCartesianWeightedDensities(std::shared_ptr<State> stat
               nv2_->full_view().begin());
     }
 
+void RosenfeldFMT::computeCartesianCosineWeightedDensities(std::shared_ptr<State> state)
+    {
+    const auto kmesh = ft_->getWavevectors();
+
+    // coefficients of the cosine series of the scalar weighted densities and of the sine series
+    // of the vector weighted densities, accumulated by type
+    setupCoefficientField(tmp_coefficient_field_["n0"]);
+    setupCoefficientField(tmp_coefficient_field_["n1"]);
+    setupCoefficientField(tmp_coefficient_field_["n2"]);
+    setupCoefficientField(tmp_coefficient_field_["n3"]);
+    setupCoefficientField(tmp_coefficient_field_["nv1"]);
+    setupCoefficientField(tmp_coefficient_field_["nv2"]);
+    std::fill(tmp_coefficient_field_["n0"]->view().begin(),
+              tmp_coefficient_field_["n0"]->view().end(),
+              0.);
+    std::fill(tmp_coefficient_field_["n1"]->view().begin(),
+              tmp_coefficient_field_["n1"]->view().end(),
+              0.);
+    std::fill(tmp_coefficient_field_["n2"]->view().begin(),
+              tmp_coefficient_field_["n2"]->view().end(),
+              0.);
+    std::fill(tmp_coefficient_field_["n3"]->view().begin(),
+              tmp_coefficient_field_["n3"]->view().end(),
+              0.);
+    std::fill(tmp_coefficient_field_["nv1"]->view().begin(),
+              tmp_coefficient_field_["nv1"]->view().end(),
+              0.);
+    std::fill(tmp_coefficient_field_["nv2"]->view().begin(),
+              tmp_coefficient_field_["nv2"]->view().end(),
+              0.);
+
+    for (const auto& t : state->getTypes())
+        {
+        // hard-sphere radius
+        const double R = 0.5 * diameters_(t);
+        if (R == 0.)
+            {
+            // no radius, no weights contribute (skip)
+            continue;
+            }
+
+        // the density is even about both reflecting boundaries, so it is a cosine series
+        ft_->setRealData(state->getField(t)->const_view());
+        ft_->transform();
+        auto rhok = ft_->const_view_coefficients();
+
+        auto n0k = tmp_coefficient_field_["n0"]->view();
+        auto n1k = tmp_coefficient_field_["n1"]->view();
+        auto n2k = tmp_coefficient_field_["n2"]->view();
+        auto n3k = tmp_coefficient_field_["n3"]->view();
+        auto nv1k = tmp_coefficient_field_["nv1"]->view();
+        auto nv2k = tmp_coefficient_field_["nv2"]->view();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(R, kmesh) \
+    shared(rhok, n0k, n1k, n2k, n3k, nv1k, nv2k)
+#endif
+        for (int idx = 0; idx < kmesh.shape(); ++idx)
+            {
+            const double k = kmesh(idx);
+
+            // compute weights at this k, using limiting values for k = 0
+            std::complex<double> w0, w1, w2, w3, wv1, wv2;
+            computeWeights(w2, w3, wv2, k, R);
+            computeProportionalByWeight(w0, w1, wv1, w2, wv2, R);
+
+            const double rho = rhok(idx);
+            n0k(idx) += std::real(w0) * rho;
+            n1k(idx) += std::real(w1) * rho;
+            n2k(idx) += std::real(w2) * rho;
+            n3k(idx) += std::real(w3) * rho;
+
+            // the odd weights turn each cosine into a sine with coefficient i*w, and the sines
+            // start from the first nonzero wavevector
+            if (idx > 0)
+                {
+                nv1k(idx - 1) -= std::imag(wv1) * rho;
+                nv2k(idx - 1) -= std::imag(wv2) * rho;
+                }
+            }
+        }
+
+    // transform n weights to real space to finish convolution
+    // no need for a factor of mesh.step() here because w is analytical
+    ft_->setCoefficients(tmp_coefficient_field_["n0"]->const_view());
+    ft_->transform();
+    std::copy(ft_->const_view_real().begin(), ft_->const_view_real().end(), n0_->view().begin());
+
+    ft_->setCoefficients(tmp_coefficient_field_["n1"]->const_view());
+    ft_->transform();
+    std::copy(ft_->const_view_real().begin(), ft_->const_view_real().end(), n1_->view().begin());
+
+    ft_->setCoefficients(tmp_coefficient_field_["n2"]->const_view());
+    ft_->transform();
+    std::copy(ft_->const_view_real().begin(), ft_->const_view_real().end(), n2_->view().begin());
+
+    ft_->setCoefficients(tmp_coefficient_field_["n3"]->const_view());
+    ft_->transform();
+    std::copy(ft_->const_view_real().begin(), ft_->const_view_real().end(), n3_->view().begin());
+
+    ft_vector_->setCoefficients(tmp_coefficient_field_["nv1"]->const_view());
+    ft_vector_->transform();
+    std::copy(ft_vector_->const_view_real().begin(),
+              ft_vector_->const_view_real().end(),
+              nv1_->view().begin());
+
+    ft_vector_->setCoefficients(tmp_coefficient_field_["nv2"]->const_view());
+    ft_vector_->transform();
+    std::copy(ft_vector_->const_view_real().begin(),
+              ft_vector_->const_view_real().end(),
+              nv2_->view().begin());
+    }
+
 void RosenfeldFMT::computeSphericalWeightedDensities(std::shared_ptr<State> state)
     {
-    const auto mesh = state->getMesh()->local().get();
+    // geometry was already checked by getConvolutionType
+    const auto mesh = static_cast<const SphericalMesh*>(state->getMesh()->local().get());
     const auto kmesh = ft_->getWavevectors();
 
     // zero the real space weighted densities for accumulation later
@@ -339,7 +491,7 @@ void RosenfeldFMT::computeSphericalWeightedDensities(std::shared_ptr<State> stat
 
             // get the fourier transformed weighted densities for this type
             {
-            fourierTransformFieldSpherical(state->getField(t)->const_full_view(), mesh);
+            fourierTransformFieldSpherical(state->getField(t)->const_full_view(), mesh, true);
             auto rhok = ft_->const_view_reciprocal();
             auto n2k = tmp_complex_field_["n2k"]->view();
             auto n3k = tmp_complex_field_["n3k"]->view();
@@ -356,9 +508,10 @@ void RosenfeldFMT::computeSphericalWeightedDensities(std::shared_ptr<State> stat
                 std::complex<double> w2, w3, wv2;
                 computeWeights(w2, w3, wv2, k, R);
 
-                n2k(idx) = w2 * rhok(idx);
-                n3k(idx) = w3 * rhok(idx);
-                nv2k(idx) = wv2 * rhok(idx);
+                const std::complex<double> rho = rhok(idx);
+                n2k(idx) = w2 * rho;
+                n3k(idx) = w3 * rho;
+                nv2k(idx) = wv2 * rho;
                 }
             }
 
@@ -400,59 +553,154 @@ void RosenfeldFMT::computeSphericalWeightedDensities(std::shared_ptr<State> stat
         // fix up n for the r values that are close to the origin
         if (mesh->lower_bound(0) < R)
             {
+            const auto& quad = getOriginQuadrature(t, mesh, R);
             const auto rho = state->getField(t)->const_view();
             auto n2i = tmp_field_["n2"]->view();
             auto n3i = tmp_field_["n3"]->view();
             auto nv2i = tmp_field_["nv2"]->view();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) shared(quad, rho, n2i, n3i, nv2i)
+#endif
+            for (int idx = 0; idx < quad.rows; ++idx)
+                {
+                const double* w2 = quad.w2.data() + idx * quad.columns;
+                const double* w3 = quad.w3.data() + idx * quad.columns;
+                const double* wv2 = quad.wv2.data() + idx * quad.columns;
+                double n2 = 0.;
+                double n3 = 0.;
+                double nv2 = 0.;
+                for (int col = 0; col < quad.columns; ++col)
+                    {
+                    const double rho_col = rho(quad.first_column + col);
+                    n2 += w2[col] * rho_col;
+                    n3 += w3[col] * rho_col;
+                    nv2 += wv2[col] * rho_col;
+                    }
+                n2i(idx) = n2;
+                n3i(idx) = n3;
+                nv2i(idx) = nv2;
+                }
+            }
+
+            // accumulate the weighted densities for the type into the total
+            {
+            auto n0 = n0_->view();
+            auto n1 = n1_->view();
+            auto n2 = n2_->view();
+            auto n3 = n3_->view();
+            auto nv1 = nv1_->view();
+            auto nv2 = nv2_->view();
 
-            for (int idx = 0; idx < std::min(mesh->bin(R), mesh->shape()); ++idx)
+            auto n2i = tmp_field_["n2"]->const_view();
+            auto n3i = tmp_field_["n3"]->const_view();
+            auto nv2i = tmp_field_["nv2"]->const_view();
+
+            for (int idx = 0; idx < mesh->shape(); ++idx)
                 {
-                // reset n for this bin
-                n2i(idx) = 0.;
-                n3i(idx) = 0.;
-                nv2i(idx) = 0.;
+                const double n2ii = n2i(idx);
+                const double nv2ii = nv2i(idx);
+                double n0i, n1i, nv1i;
+                computeProportionalByWeight(n0i, n1i, nv1i, n2ii, nv2ii, R);
 
-                // take integrals using trapezoidal rule
-                const auto r = mesh->center(idx);
+                n0(idx) += n0i;
+                n1(idx) += n1i;
+                n2(idx) += n2i(idx);
+                n3(idx) += n3i(idx);
+                nv1(idx) += nv1i;
+                nv2(idx) += nv2i(idx);
+                }
+            }
+        }
+    }
 
-                const double lower = 0;
-                const double split = R - r;
-                const double upper = r + R;
+void RosenfeldFMT::computeSphericalSineWeightedDensities(std::shared_ptr<State> state)
+    {
+    // geometry was already checked by getConvolutionType
+    const auto mesh = static_cast<const SphericalMesh*>(state->getMesh()->local().get());
+    const auto kmesh = ft_->getWavevectors();
 
-                // initializing n3 integrals
-                double n3_ig_1 = 0;
-                double n3_ig_2 = 0;
+    // zero the real space weighted densities for accumulation later
+    std::fill(n0_->view().begin(), n0_->view().end(), 0.);
+    std::fill(n1_->view().begin(), n1_->view().end(), 0.);
+    std::fill(n2_->view().begin(), n2_->view().end(), 0.);
+    std::fill(n3_->view().begin(), n3_->view().end(), 0.);
+    std::fill(nv1_->view().begin(), nv1_->view().end(), 0.);
+    std::fill(nv2_->view().begin(), nv2_->view().end(), 0.);
 
-                // integral from 0 to R-r
-                const int n = 100;
-                double x = lower;
-                double dr = (split - lower) / n;
-                for (int ig_idx = 0; ig_idx <= n; ig_idx++)
-                    {
-                    const double factor = (ig_idx == 0 || ig_idx == n) ? 0.5 : 1.0;
-                    double rho_ig = mesh->interpolate(x, rho);
-                    n3_ig_1 += factor * 4 * M_PI * x * x * rho_ig;
-                    x += dr;
-                    }
-                n3_ig_1 *= dr;
+    // weighted densities by type
+    setupField(tmp_field_["n2"]);
+    setupField(tmp_field_["n3"]);
+    setupField(tmp_field_["nv2"]);
+    setupCoefficientField(tmp_coefficient_field_["n2"]);
+    setupCoefficientField(tmp_coefficient_field_["n3"]);
+    setupCoefficientField(tmp_coefficient_field_["dn3"]);
 
-                // Integral from R-r to r+R
-                x = split;
-                dr = (upper - split) / n;
+    for (const auto& t : state->getTypes())
+        {
+        // hard-sphere radius
+        const double R = 0.5 * diameters_(t);
+        if (R == 0.)
+            {
+            // no radius, no weights contribute (skip)
+            continue;
+            }
 
-                for (int ig_idx = 0; ig_idx <= n; ig_idx++)
-                    {
-                    const double factor = (ig_idx == 0 || ig_idx == n) ? 0.5 : 1.0;
-                    const auto rho_ig = mesh->interpolate(x, rho);
-                    n3_ig_2 += factor * (M_PI / r) * (rho_ig * x * (R * R - (r - x) * (r - x)));
-                    n2i(idx) += factor * (2. * M_PI * R / r) * rho_ig * x;
-                    nv2i(idx) += factor * (M_PI / (r * r)) * (rho_ig * x * (R * R + r * r - x * x));
-                    x += dr;
-                    }
+            // r rho is odd about the origin, so r n2 and r n3 are sine series, and the radial
+            // derivative of r n3 that gives nv2 is a cosine series over the same wavevectors
+            {
+            fourierTransformFieldRadial(*ft_, state->getField(t)->const_view(), mesh, true);
+            auto rhok = ft_->const_view_coefficients();
+            auto n2k = tmp_coefficient_field_["n2"]->view();
+            auto n3k = tmp_coefficient_field_["n3"]->view();
+            auto dn3k = tmp_coefficient_field_["dn3"]->view();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(R, kmesh) \
+    shared(rhok, n2k, n3k, dn3k)
+#endif
+            for (int idx = 0; idx < kmesh.shape(); ++idx)
+                {
+                const double k = kmesh(idx);
 
-                n3i(idx) = n3_ig_1 + n3_ig_2 * dr;
-                n2i(idx) *= dr;
-                nv2i(idx) *= dr;
+                std::complex<double> w2, w3, wv2;
+                computeWeights(w2, w3, wv2, k, R);
+
+                const double rho = rhok(idx);
+                n2k(idx) = std::real(w2) * rho;
+                n3k(idx) = std::real(w3) * rho;
+                dn3k(idx) = k * std::real(w3) * rho;
+                }
+            }
+
+        // transform n weights to real space to finish convolution, keeping only the mesh
+        ft_->setCoefficients(tmp_coefficient_field_["n2"]->const_view());
+        ft_->transform();
+        std::copy(ft_->const_view_real().begin(),
+                  ft_->const_view_real().begin() + mesh->shape(),
+                  tmp_field_["n2"]->view().begin());
+
+        ft_->setCoefficients(tmp_coefficient_field_["n3"]->const_view());
+        ft_->transform();
+        std::copy(ft_->const_view_real().begin(),
+                  ft_->const_view_real().begin() + mesh->shape(),
+                  tmp_field_["n3"]->view().begin());
+
+        ft_vector_->setCoefficients(tmp_coefficient_field_["dn3"]->const_view());
+        ft_vector_->transform();
+        std::copy(ft_vector_->const_view_real().begin(),
+                  ft_vector_->const_view_real().begin() + mesh->shape(),
+                  tmp_field_["nv2"]->view().begin());
+
+            // divide through by r, using nv2 = -dn3/dr = -d(r n3)/dr / r + n3 / r
+            {
+            auto n2i = tmp_field_["n2"]->view();
+            auto n3i = tmp_field_["n3"]->view();
+            auto nv2i = tmp_field_["nv2"]->view();
+            for (int idx = 0; idx < mesh->shape(); ++idx)
+                {
+                const auto r = mesh->center(idx);
+                n2i(idx) /= r;
+                n3i(idx) /= r;
+                nv2i(idx) = -nv2i(idx) / r + n3i(idx) / r;
                 }
             }
 
@@ -471,8 +719,10 @@ void RosenfeldFMT::computeSphericalWeightedDensities(std::shared_ptr<State> stat
 
             for (int idx = 0; idx < mesh->shape(); ++idx)
                 {
+                const double n2ii = n2i(idx);
+                const double nv2ii = nv2i(idx);
                 double n0i, n1i, nv1i;
-                computeProportionalByWeight(n0i, n1i, nv1i, n2i(idx), nv2i(idx), R);
+                computeProportionalByWeight(n0i, n1i, nv1i, n2ii, nv2ii, R);
 
                 n0(idx) += n0i;
                 n1(idx) += n1i;
@@ -487,7 +737,8 @@ void RosenfeldFMT::computeSphericalWeightedDensities(std::shared_ptr<State> stat
 
 void RosenfeldFMT::computeCartesianDerivative(std::shared_ptr<State> state)
     {
-    const auto mesh = state->getMesh()->local().get();
+    // geometry was already checked by getConvolutionType
+    const auto mesh = static_cast<const CartesianMesh*>(state->getMesh()->local().get());
     const auto kmesh = ft_->getWavevectors();
 
         // convert phi derivatives to Fourier space
@@ -568,9 +819,14 @@ void RosenfeldFMT::computeCartesianDerivative(std::shared_ptr<State> state)
 
                 // convolution (note opposite sign for vector weights due to change of order in
                 // convolution)
-                derivativek(idx)
-                    = (dphi_dn0k(idx) * w0 + dphi_dn1k(idx) * w1 + dphi_dn2k(idx) * w2
-                       + dphi_dn3k(idx) * w3 - dphi_dnv1k(idx) * wv1 - dphi_dnv2k(idx) * wv2);
+                const std::complex<double> dphi_dn0 = dphi_dn0k(idx);
+                const std::complex<double> dphi_dn1 = dphi_dn1k(idx);
+                const std::complex<double> dphi_dn2 = dphi_dn2k(idx);
+                const std::complex<double> dphi_dn3 = dphi_dn3k(idx);
+                const std::complex<double> dphi_dnv1 = dphi_dnv1k(idx);
+                const std::complex<double> dphi_dnv2 = dphi_dnv2k(idx);
+                derivativek(idx) = (dphi_dn0 * w0 + dphi_dn1 * w1 + dphi_dn2 * w2 + dphi_dn3 * w3
+                                    - dphi_dnv1 * wv1 - dphi_dnv2 * wv2);
                 }
             ft_->setReciprocalData(derivativek);
             ft_->transform();
@@ -601,9 +857,128 @@ void RosenfeldFMT::computeCartesianDerivative(std::shared_ptr<State> state)
         }
     }
 
+void RosenfeldFMT::computeCartesianCosineDerivative(std::shared_ptr<State> state)
+    {
+    const auto kmesh = ft_->getWavevectors();
+
+    // convert phi derivatives to Fourier space, which are cosine series for the scalar weighted
+    // densities and sine series for the vector weighted densities
+    setupCoefficientField(tmp_coefficient_field_["dphi_dn0"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dn1"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dn2"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dn3"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dnv1"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dnv2"]);
+
+    ft_->setRealData(dphi_dn0_->const_view());
+    ft_->transform();
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dn0"]->view().begin());
+
+    ft_->setRealData(dphi_dn1_->const_view());
+    ft_->transform();
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dn1"]->view().begin());
+
+    ft_->setRealData(dphi_dn2_->const_view());
+    ft_->transform();
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dn2"]->view().begin());
+
+    ft_->setRealData(dphi_dn3_->const_view());
+    ft_->transform();
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dn3"]->view().begin());
+
+    ft_vector_->setRealData(dphi_dnv1_->const_view());
+    ft_vector_->transform();
+    std::copy(ft_vector_->const_view_coefficients().begin(),
+              ft_vector_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dnv1"]->view().begin());
+
+    ft_vector_->setRealData(dphi_dnv2_->const_view());
+    ft_vector_->transform();
+    std::copy(ft_vector_->const_view_coefficients().begin(),
+              ft_vector_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dnv2"]->view().begin());
+
+    setupCoefficientField(tmp_coefficient_field_["derivative"]);
+
+        // convolve phi derivatives with weights to get functional derivatives
+        // again, no need for a factor of mesh.step() here because w is analytical
+        {
+        auto dphi_dn0k = tmp_coefficient_field_["dphi_dn0"]->const_view();
+        auto dphi_dn1k = tmp_coefficient_field_["dphi_dn1"]->const_view();
+        auto dphi_dn2k = tmp_coefficient_field_["dphi_dn2"]->const_view();
+        auto dphi_dn3k = tmp_coefficient_field_["dphi_dn3"]->const_view();
+        auto dphi_dnv1k = tmp_coefficient_field_["dphi_dnv1"]->const_view();
+        auto dphi_dnv2k = tmp_coefficient_field_["dphi_dnv2"]->const_view();
+
+        auto derivativek = tmp_coefficient_field_["derivative"]->view();
+        for (const auto& t : state->getTypes())
+            {
+            // hard-sphere radius
+            const double R = 0.5 * diameters_(t);
+            if (R == 0.)
+                {
+                // no radius, no contribution to energy
+                // need to set here as we are not prefilling the array with zeros
+                auto derivative = derivatives_(t)->view();
+                std::fill(derivative.begin(), derivative.end(), 0.0);
+                continue;
+                }
+
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(kmesh, R) \
+    shared(derivativek, dphi_dn0k, dphi_dn1k, dphi_dn2k, dphi_dn3k, dphi_dnv1k, dphi_dnv2k)
+#endif
+            for (int idx = 0; idx < kmesh.shape(); ++idx)
+                {
+                const double k = kmesh(idx);
+
+                // get weights
+                std::complex<double> w0, w1, w2, w3, wv1, wv2;
+                computeWeights(w2, w3, wv2, k, R);
+                computeProportionalByWeight(w0, w1, wv1, w2, wv2, R);
+
+                // the odd weights turn each sine back into a cosine with coefficient i*w, which
+                // has the same sign as for the weighted densities because the order of the
+                // convolution is also reversed
+                double value = std::real(w0) * dphi_dn0k(idx) + std::real(w1) * dphi_dn1k(idx)
+                               + std::real(w2) * dphi_dn2k(idx) + std::real(w3) * dphi_dn3k(idx);
+                if (idx > 0)
+                    {
+                    value -= std::imag(wv1) * dphi_dnv1k(idx - 1)
+                             + std::imag(wv2) * dphi_dnv2k(idx - 1);
+                    }
+                derivativek(idx) = value;
+                }
+            ft_->setCoefficients(tmp_coefficient_field_["derivative"]->const_view());
+            ft_->transform();
+            std::copy(ft_->const_view_real().begin(),
+                      ft_->const_view_real().end(),
+                      derivatives_(t)->view().begin());
+
+            // start communicating this type
+            state->getMesh()->startSync(derivatives_(t));
+            }
+        }
+
+    // finish up communication of all types
+    for (const auto& t : state->getTypes())
+        {
+        state->getMesh()->endSync(derivatives_(t));
+        }
+    }
+
 void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
     {
-    const auto mesh = state->getMesh()->local().get();
+    // geometry was already checked by getConvolutionType
+    const auto mesh = static_cast<const SphericalMesh*>(state->getMesh()->local().get());
     const auto kmesh = ft_->getWavevectors();
 
     // these temporary variables will be used for convolutions of each derivative per type
@@ -613,8 +988,6 @@ void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
     setupField(tmp_field_["dF_dn3"]);
     setupField(tmp_field_["dF_dnv1"]);
     setupField(tmp_field_["dF_dnv2"]);
-    setupField(tmp_field_["dF_dnv2_2"]);
-    setupField(tmp_field_["dF_dnv1_2"]);
 
     setupComplexField(tmp_complex_field_["dphi_dn0k_w0k"]);
     setupComplexField(tmp_complex_field_["dphi_dn1k_w1k"]);
@@ -622,46 +995,57 @@ void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
     setupComplexField(tmp_complex_field_["dphi_dn3k_w3k"]);
     setupComplexField(tmp_complex_field_["dphi_dnv1k_wv1k"]);
     setupComplexField(tmp_complex_field_["dphi_dnv2k_wv2k"]);
-    setupComplexField(tmp_complex_field_["dphi_dnv2k_w3k"]);
-    setupComplexField(tmp_complex_field_["dphi_dnv1k_w3k"]);
+    setupComplexField(tmp_complex_field_["dphi_dnv1k_unscaled"]);
+    setupComplexField(tmp_complex_field_["dphi_dnv2k_unscaled"]);
         // convert phi derivatives to Fourier space for convolution, accounting for factor of r
         // these can be reused by all of the types, so we compute them first outside the type loop
         {
         // dphi_dn0
-        fourierTransformFieldSpherical(dphi_dn0_->const_full_view(), mesh);
+        fourierTransformFieldSpherical(dphi_dn0_->const_full_view(), mesh, true);
         std::copy(ft_->const_view_reciprocal().begin(),
                   ft_->const_view_reciprocal().end(),
                   dphi_dn0k_->full_view().begin());
 
         // dphi_dn1
-        fourierTransformFieldSpherical(dphi_dn1_->const_full_view(), mesh);
+        fourierTransformFieldSpherical(dphi_dn1_->const_full_view(), mesh, true);
         std::copy(ft_->const_view_reciprocal().begin(),
                   ft_->const_view_reciprocal().end(),
                   dphi_dn1k_->full_view().begin());
 
         // dphi_dn2
-        fourierTransformFieldSpherical(dphi_dn2_->const_full_view(), mesh);
+        fourierTransformFieldSpherical(dphi_dn2_->const_full_view(), mesh, true);
         std::copy(ft_->const_view_reciprocal().begin(),
                   ft_->const_view_reciprocal().end(),
                   dphi_dn2k_->full_view().begin());
 
         // dphi_dn3
-        fourierTransformFieldSpherical(dphi_dn3_->const_full_view(), mesh);
+        fourierTransformFieldSpherical(dphi_dn3_->const_full_view(), mesh, true);
         std::copy(ft_->const_view_reciprocal().begin(),
                   ft_->const_view_reciprocal().end(),
                   dphi_dn3k_->full_view().begin());
 
         // dphi_dnv1
-        fourierTransformFieldSpherical(dphi_dnv1_->const_full_view(), mesh);
+        fourierTransformFieldSpherical(dphi_dnv1_->const_full_view(), mesh, true);
         std::copy(ft_->const_view_reciprocal().begin(),
                   ft_->const_view_reciprocal().end(),
                   dphi_dnv1k_->full_view().begin());
 
         // dphi_dnv2
-        fourierTransformFieldSpherical(dphi_dnv2_->const_full_view(), mesh);
+        fourierTransformFieldSpherical(dphi_dnv2_->const_full_view(), mesh, true);
         std::copy(ft_->const_view_reciprocal().begin(),
                   ft_->const_view_reciprocal().end(),
                   dphi_dnv2k_->full_view().begin());
+
+        // the divergence of the vector phi derivatives also needs them without the factor of r
+        fourierTransformFieldSpherical(dphi_dnv1_->const_full_view(), mesh, false);
+        std::copy(ft_->const_view_reciprocal().begin(),
+                  ft_->const_view_reciprocal().end(),
+                  tmp_complex_field_["dphi_dnv1k_unscaled"]->full_view().begin());
+
+        fourierTransformFieldSpherical(dphi_dnv2_->const_full_view(), mesh, false);
+        std::copy(ft_->const_view_reciprocal().begin(),
+                  ft_->const_view_reciprocal().end(),
+                  tmp_complex_field_["dphi_dnv2k_unscaled"]->full_view().begin());
         }
 
     for (const auto& t : state->getTypes())
@@ -685,14 +1069,14 @@ void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
             auto dphi_dn3k = dphi_dn3k_->const_view();
             auto dphi_dnv1k = dphi_dnv1k_->const_view();
             auto dphi_dnv2k = dphi_dnv2k_->const_view();
+            auto dphi_dnv1k_unscaled = tmp_complex_field_["dphi_dnv1k_unscaled"]->const_view();
+            auto dphi_dnv2k_unscaled = tmp_complex_field_["dphi_dnv2k_unscaled"]->const_view();
             auto dphi_dn0k_w0k = tmp_complex_field_["dphi_dn0k_w0k"]->view();
             auto dphi_dn1k_w1k = tmp_complex_field_["dphi_dn1k_w1k"]->view();
             auto dphi_dn2k_w2k = tmp_complex_field_["dphi_dn2k_w2k"]->view();
             auto dphi_dn3k_w3k = tmp_complex_field_["dphi_dn3k_w3k"]->view();
             auto dphi_dnv1k_wv1k = tmp_complex_field_["dphi_dnv1k_wv1k"]->view();
             auto dphi_dnv2k_wv2k = tmp_complex_field_["dphi_dnv2k_wv2k"]->view();
-            auto dphi_dnv2k_w3k = tmp_complex_field_["dphi_dnv2k_w3k"]->view();
-            auto dphi_dnv1k_w3k = tmp_complex_field_["dphi_dnv1k_w3k"]->view();
 
             for (int idx = 0; idx < kmesh.shape(); ++idx)
                 {
@@ -702,16 +1086,26 @@ void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
                 computeWeights(w2, w3, wv2, k, R);
                 computeProportionalByWeight(w0, w1, wv1, w2, wv2, R);
 
-                dphi_dn0k_w0k(idx) = dphi_dn0k(idx) * w0;
-                dphi_dn1k_w1k(idx) = dphi_dn1k(idx) * w1;
-                dphi_dn2k_w2k(idx) = dphi_dn2k(idx) * w2;
-                dphi_dn3k_w3k(idx) = dphi_dn3k(idx) * w3;
-                // sign is opposite here due to oddness of weight function and reversed order
-                dphi_dnv1k_wv1k(idx) = -dphi_dnv1k(idx) * wv1;
-                dphi_dnv2k_wv2k(idx) = -dphi_dnv2k(idx) * wv2;
-                // TODO: there is a missing term for nv1 and nv2
-                dphi_dnv2k_w3k(idx) = -dphi_dnv2k(idx) * w3;
-                dphi_dnv1k_w3k(idx) = -dphi_dnv1k(idx) * w3;
+                const std::complex<double> dphi_dn0 = dphi_dn0k(idx);
+                const std::complex<double> dphi_dn1 = dphi_dn1k(idx);
+                const std::complex<double> dphi_dn2 = dphi_dn2k(idx);
+                const std::complex<double> dphi_dn3 = dphi_dn3k(idx);
+                const std::complex<double> dphi_dnv1 = dphi_dnv1k(idx);
+                const std::complex<double> dphi_dnv2 = dphi_dnv2k(idx);
+                const std::complex<double> dphi_dnv1_unscaled = dphi_dnv1k_unscaled(idx);
+                const std::complex<double> dphi_dnv2_unscaled = dphi_dnv2k_unscaled(idx);
+                dphi_dn0k_w0k(idx) = dphi_dn0 * w0;
+                dphi_dn1k_w1k(idx) = dphi_dn1 * w1;
+                dphi_dn2k_w2k(idx) = dphi_dn2 * w2;
+                dphi_dn3k_w3k(idx) = dphi_dn3 * w3;
+                // r times the divergence of a radial vector field G is d(r G)/dr + G, so r times
+                // its convolution with w3 has a term with wv1 or wv2 acting on r G (sign is
+                // opposite here due to oddness of weight function and reversed order) and a term
+                // with w3 acting on G, which scales like wv1 for nv1. both are divided by r
+                // afterwards, so they are summed before the transform.
+                dphi_dnv1k_wv1k(idx)
+                    = -dphi_dnv1 * wv1 + dphi_dnv1_unscaled * w3 / (4. * M_PI * R);
+                dphi_dnv2k_wv2k(idx) = -dphi_dnv2 * wv2 + dphi_dnv2_unscaled * w3;
                 }
 
             ft_->setReciprocalData(dphi_dn0k_w0k);
@@ -749,18 +1143,6 @@ void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
             std::copy(ft_->const_view_real().begin(),
                       ft_->const_view_real().end(),
                       tmp_field_["dF_dnv2"]->full_view().begin());
-
-            ft_->setReciprocalData(dphi_dnv2k_w3k);
-            ft_->transform();
-            std::copy(ft_->const_view_real().begin(),
-                      ft_->const_view_real().end(),
-                      tmp_field_["dF_dnv2_2"]->full_view().begin());
-
-            ft_->setReciprocalData(dphi_dnv1k_w3k);
-            ft_->transform();
-            std::copy(ft_->const_view_real().begin(),
-                      ft_->const_view_real().end(),
-                      tmp_field_["dF_dnv2_2"]->full_view().begin());
             }
 
             // normalize phi derivatives with r
@@ -771,8 +1153,6 @@ void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
             auto dF_dn3 = tmp_field_["dF_dn3"]->view();
             auto dF_dnv1 = tmp_field_["dF_dnv1"]->view();
             auto dF_dnv2 = tmp_field_["dF_dnv2"]->view();
-            auto dF_dnv2_2 = tmp_field_["dF_dnv2_2"]->view();
-            auto dF_dnv1_2 = tmp_field_["dF_dnv1_2"]->view();
 
             for (int idx = 0; idx < mesh->shape(); ++idx)
                 {
@@ -783,9 +1163,6 @@ void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
                 dF_dn3(idx) /= r;
                 dF_dnv1(idx) /= r;
                 dF_dnv2(idx) /= r;
-                // TODO: extra term for nv1 and nv2
-                dF_dnv2(idx) += dF_dnv2_2(idx) / (r * r);
-                dF_dnv1(idx) += dF_dnv1_2(idx) / (r * r);
                 }
             }
 
@@ -806,84 +1183,42 @@ void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
             auto dF_dnv1 = tmp_field_["dF_dnv1"]->view();
             auto dF_dnv2 = tmp_field_["dF_dnv2"]->view();
 
-            for (int idx = 0; idx < std::min(mesh->bin(R), mesh->shape()); ++idx)
+            const auto& quad = getOriginQuadrature(t, mesh, R);
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(R) \
+    shared(quad, dphi_dn0, dphi_dn1, dphi_dn2, dphi_dn3, dphi_dnv1, dphi_dnv2, dF_dn0, dF_dn1, \
+           dF_dn2, dF_dn3, dF_dnv1, dF_dnv2)
+#endif
+            for (int idx = 0; idx < quad.rows; ++idx)
                 {
-                // reset values for this bin
-                dF_dn0(idx) = 0.;
-                dF_dn1(idx) = 0.;
-                dF_dn2(idx) = 0.;
-                dF_dn3(idx) = 0.;
-                dF_dnv1(idx) = 0.;
-                dF_dnv2(idx) = 0.;
-
-                double dF_dn3_1 = 0;
-                double dF_dn3_2 = 0;
-                // take integrals using quadrature
-                const auto r = mesh->center(idx);
-                const double lower = 0.;
-                const double split = R - r;
-                const double upper = r + R;
-                const double sq_R = R * R;
-                const double sq_r = r * r;
-
-                // integral 1
-                // we have found 100 points works well
-
-                const int n = 100;
-                double dr = (split - lower) / n;
-                double x = lower;
-
-                for (int ig_idx = 0; ig_idx <= n; ++ig_idx)
+                const double* w2 = quad.w2.data() + idx * quad.columns;
+                const double* w3 = quad.w3.data() + idx * quad.columns;
+                const double* dwv2 = quad.dwv2.data() + idx * quad.columns;
+                double w2_dn0 = 0.;
+                double w2_dn1 = 0.;
+                double w2_dn2 = 0.;
+                double w3_dn3 = 0.;
+                double dwv2_dnv1 = 0.;
+                double dwv2_dnv2 = 0.;
+                for (int col = 0; col < quad.columns; ++col)
                     {
-                    const auto dphi_dn3_ig = mesh->interpolate(x, dphi_dn3);
-                    const double factor = (ig_idx == 0 || ig_idx == n) ? 0.5 : 1.0;
-                    dF_dn3_1 += factor * 4. * M_PI * dphi_dn3_ig * (x * x);
-                    x += dr;
+                    const int bin = quad.first_column + col;
+                    w2_dn0 += w2[col] * dphi_dn0(bin);
+                    w2_dn1 += w2[col] * dphi_dn1(bin);
+                    w2_dn2 += w2[col] * dphi_dn2(bin);
+                    w3_dn3 += w3[col] * dphi_dn3(bin);
+                    dwv2_dnv1 += dwv2[col] * dphi_dnv1(bin);
+                    dwv2_dnv2 += dwv2[col] * dphi_dnv2(bin);
                     }
-                dF_dn3_1 *= dr;
 
-                // Integral 2
-                dr = (upper - split) / n;
-                x = split;
-
-                for (int ig_idx = 0; ig_idx <= n; ++ig_idx)
-                    {
-                    const double kernel_w3 = x * (M_PI / r) * (sq_R - (r - x) * (r - x));
-                    const double kernel_w2 = x * (2. * M_PI * R / r);
-                    // minus sign for wv2 kernel to account for swap of variables in convolution
-                    // with odd function
-                    const double kernel_wv2 = -x * (M_PI / (sq_r)) * (sq_R + sq_r - x * x);
-                    double kernel_w0, kernel_w1, kernel_wv1;
-                    computeProportionalByWeight(kernel_w0,
-                                                kernel_w1,
-                                                kernel_wv1,
-                                                kernel_w2,
-                                                kernel_wv2,
-                                                R);
-
-                    const double factor = (ig_idx == 0 || ig_idx == n) ? 0.5 : 1.0;
-                    const auto dphi_dn0_ig = mesh->interpolate(x, dphi_dn0);
-                    const auto dphi_dn1_ig = mesh->interpolate(x, dphi_dn1);
-                    const auto dphi_dn2_ig = mesh->interpolate(x, dphi_dn2);
-                    const auto dphi_dn3_ig = mesh->interpolate(x, dphi_dn3);
-                    const auto dphi_dnv1_ig = mesh->interpolate(x, dphi_dnv1);
-                    const auto dphi_dnv2_ig = mesh->interpolate(x, dphi_dnv2);
-
-                    dF_dn0(idx) += factor * dphi_dn0_ig * kernel_w0;
-                    dF_dn1(idx) += factor * dphi_dn1_ig * kernel_w1;
-                    dF_dn2(idx) += factor * dphi_dn2_ig * kernel_w2;
-                    dF_dn3_2 += factor * dphi_dn3_ig * kernel_w3;
-                    dF_dnv1(idx) += factor * dphi_dnv1_ig * kernel_wv1;
-                    dF_dnv2(idx) += factor * dphi_dnv2_ig * kernel_wv2;
-                    x += dr;
-                    }
-
-                dF_dn0(idx) *= dr;
-                dF_dn1(idx) *= dr;
-                dF_dn2(idx) *= dr;
-                dF_dn3(idx) = dF_dn3_1 + dF_dn3_2 * dr;
-                dF_dnv1(idx) *= dr;
-                dF_dnv2(idx) *= dr;
+                // w0, w1, and wv1 are proportional to w2 and wv2
+                const double factor = 1. / (4. * M_PI * R);
+                dF_dn0(idx) = factor * w2_dn0 / R;
+                dF_dn1(idx) = factor * w2_dn1;
+                dF_dn2(idx) = w2_dn2;
+                dF_dn3(idx) = w3_dn3;
+                dF_dnv1(idx) = factor * dwv2_dnv1;
+                dF_dnv2(idx) = dwv2_dnv2;
                 }
             }
 
@@ -920,6 +1255,150 @@ void RosenfeldFMT::computeSphericalDerivative(std::shared_ptr<State> state)
         }
     }
 
+void RosenfeldFMT::computeSphericalSineDerivative(std::shared_ptr<State> state)
+    {
+    // geometry was already checked by getConvolutionType
+    const auto mesh = static_cast<const SphericalMesh*>(state->getMesh()->local().get());
+    const auto kmesh = ft_->getWavevectors();
+
+    // convert phi derivatives to Fourier space, which are sine series of r times the scalar phi
+    // derivatives, and sine series of the vector phi derivatives along with cosine series of r
+    // times them to take their divergence, all of which can be reused by all of the types
+    setupCoefficientField(tmp_coefficient_field_["dphi_dn0"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dn1"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dn2"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dn3"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dnv1_sin"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dnv2_sin"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dnv1_cos"]);
+    setupCoefficientField(tmp_coefficient_field_["dphi_dnv2_cos"]);
+
+    fourierTransformFieldRadial(*ft_, dphi_dn0_->const_view(), mesh, true);
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dn0"]->view().begin());
+
+    fourierTransformFieldRadial(*ft_, dphi_dn1_->const_view(), mesh, true);
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dn1"]->view().begin());
+
+    fourierTransformFieldRadial(*ft_, dphi_dn2_->const_view(), mesh, true);
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dn2"]->view().begin());
+
+    fourierTransformFieldRadial(*ft_, dphi_dn3_->const_view(), mesh, true);
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dn3"]->view().begin());
+
+    fourierTransformFieldRadial(*ft_, dphi_dnv1_->const_view(), mesh, false);
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dnv1_sin"]->view().begin());
+
+    fourierTransformFieldRadial(*ft_, dphi_dnv2_->const_view(), mesh, false);
+    std::copy(ft_->const_view_coefficients().begin(),
+              ft_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dnv2_sin"]->view().begin());
+
+    fourierTransformFieldRadial(*ft_vector_, dphi_dnv1_->const_view(), mesh, true);
+    std::copy(ft_vector_->const_view_coefficients().begin(),
+              ft_vector_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dnv1_cos"]->view().begin());
+
+    fourierTransformFieldRadial(*ft_vector_, dphi_dnv2_->const_view(), mesh, true);
+    std::copy(ft_vector_->const_view_coefficients().begin(),
+              ft_vector_->const_view_coefficients().end(),
+              tmp_coefficient_field_["dphi_dnv2_cos"]->view().begin());
+
+    setupCoefficientField(tmp_coefficient_field_["derivative"]);
+
+        // convolve phi derivatives with weights to get r times the functional derivatives
+        {
+        auto dphi_dn0k = tmp_coefficient_field_["dphi_dn0"]->const_view();
+        auto dphi_dn1k = tmp_coefficient_field_["dphi_dn1"]->const_view();
+        auto dphi_dn2k = tmp_coefficient_field_["dphi_dn2"]->const_view();
+        auto dphi_dn3k = tmp_coefficient_field_["dphi_dn3"]->const_view();
+        auto dphi_dnv1k_sin = tmp_coefficient_field_["dphi_dnv1_sin"]->const_view();
+        auto dphi_dnv2k_sin = tmp_coefficient_field_["dphi_dnv2_sin"]->const_view();
+        auto dphi_dnv1k_cos = tmp_coefficient_field_["dphi_dnv1_cos"]->const_view();
+        auto dphi_dnv2k_cos = tmp_coefficient_field_["dphi_dnv2_cos"]->const_view();
+
+        auto derivativek = tmp_coefficient_field_["derivative"]->view();
+        for (const auto& t : state->getTypes())
+            {
+            // hard-sphere radius
+            const double R = 0.5 * diameters_(t);
+            if (R == 0.)
+                {
+                // no radius, no contribution to energy
+                // need to set here as we are not prefilling the array with zeros
+                auto derivative = derivatives_(t)->view();
+                std::fill(derivative.begin(), derivative.end(), 0.0);
+                continue;
+                }
+
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(kmesh, R) \
+    shared(derivativek,                                                     \
+               dphi_dn0k,                                                   \
+               dphi_dn1k,                                                   \
+               dphi_dn2k,                                                   \
+               dphi_dn3k,                                                   \
+               dphi_dnv1k_sin,                                              \
+               dphi_dnv2k_sin,                                              \
+               dphi_dnv1k_cos,                                              \
+               dphi_dnv2k_cos)
+#endif
+            for (int idx = 0; idx < kmesh.shape(); ++idx)
+                {
+                const double k = kmesh(idx);
+
+                // get the scalar weights, and the weights for the vector phi derivatives, which
+                // are convolved with w3 after taking their divergence and scale like wv1 and wv2
+                std::complex<double> w2c, w3c, wv2c;
+                computeWeights(w2c, w3c, wv2c, k, R);
+                const double w2 = std::real(w2c);
+                const double w3 = std::real(w3c);
+                double w0, w1, w3_v1;
+                computeProportionalByWeight(w0, w1, w3_v1, w2, w3, R);
+
+                // the sine series of r times the divergence of a radial vector field G has
+                // coefficients S[G] - k C[r G], with S and C the sine and cosine series
+                derivativek(idx)
+                    = (w0 * dphi_dn0k(idx) + w1 * dphi_dn1k(idx) + w2 * dphi_dn2k(idx)
+                       + w3 * dphi_dn3k(idx)
+                       + w3_v1 * (dphi_dnv1k_sin(idx) - k * dphi_dnv1k_cos(idx))
+                       + w3 * (dphi_dnv2k_sin(idx) - k * dphi_dnv2k_cos(idx)));
+                }
+            ft_->setCoefficients(tmp_coefficient_field_["derivative"]->const_view());
+            ft_->transform();
+
+            // copy the values on the mesh, dividing through by r
+            auto din = ft_->const_view_real();
+            auto dout = derivatives_(t)->view();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(mesh) shared(din, dout)
+#endif
+            for (int idx = 0; idx < mesh->shape(); ++idx)
+                {
+                dout(idx) = din(idx) / mesh->center(idx);
+                }
+
+            // start communicating this type
+            state->getMesh()->startSync(derivatives_(t));
+            }
+        }
+
+    // finish up communication of all types
+    for (const auto& t : state->getTypes())
+        {
+        state->getMesh()->endSync(derivatives_(t));
+        }
+    }
+
 void RosenfeldFMT::computePrefactorFunctions(double& f1,
                                              double& f2,
                                              double& f4,
@@ -1024,44 +1503,159 @@ bool RosenfeldFMT::setup(std::shared_ptr<State> state, bool compute_value)
     // this will setup buffer_shape_ indirectly
     bool compute = Functional::setup(state, compute_value);
 
-    // update Fourier transform to mesh shape + buffer
+    // update Fourier transform to the mesh shape, padded by the buffer on sides that are not
+    // represented by the symmetry of the transform. Ends that are only a buffer can be padded
+    // further to a size that transforms quickly. The padding mirrors the data, or bridges it
+    // linearly back to the first point if periodic, rather than filling it with zeros.
     const auto mesh = state->getMesh()->local().get();
-    const int buffered_shape = mesh->shape() + 2 * buffer_shape_;
-    const double buffered_L = mesh->asLength(buffered_shape);
-    if (!ft_ || buffered_L != ft_->getL() || buffered_shape != ft_->getN())
+    const auto conv_type = getConvolutionType(state->getMesh()->local());
+    shape_ = mesh->shape();
+    int ft_shape = shape_ + 2 * buffer_shape_;
+    auto symmetry = FourierTransform::Symmetry::periodic;
+    auto vector_symmetry = FourierTransform::Symmetry::periodic;
+    bool pad = true;
+    if (conv_type == ConvolutionType::cartesian_cosine)
+        {
+        // the cosine series mirrors about the ends of the mesh, halfway between the first or last
+        // point and its image, whereas the buffer of a reflecting lower boundary mirrors about
+        // the first point
+        ft_shape = shape_;
+        symmetry = FourierTransform::Symmetry::even;
+        vector_symmetry = FourierTransform::Symmetry::odd;
+        pad = false;
+        }
+    else if (conv_type == ConvolutionType::spherical_sine)
+        {
+        ft_shape = shape_ + buffer_shape_;
+        symmetry = FourierTransform::Symmetry::odd_even;
+        vector_symmetry = FourierTransform::Symmetry::even_odd;
+        }
+    const double ft_L = mesh->asLength(ft_shape);
+    if (!ft_ || ft_L != ft_->getL() || ft_shape != ft_->getN() || symmetry != ft_->getSymmetry())
+        {
+        ft_ = std::make_unique<FourierTransform>(ft_L, ft_shape, symmetry, pad);
+        tmp_coefficient_field_.clear();
+        }
+    if (symmetry == FourierTransform::Symmetry::periodic)
+        {
+        ft_vector_.reset();
+        }
+    else if (!ft_vector_ || ft_L != ft_vector_->getL() || ft_shape != ft_vector_->getN()
+             || vector_symmetry != ft_vector_->getSymmetry())
         {
-        ft_ = std::make_unique<FourierTransform>(buffered_L, buffered_shape);
+        ft_vector_ = std::make_unique<FourierTransform>(ft_L, ft_shape, vector_symmetry, pad);
         }
 
     // update shape of internal fields
     setupField(n0_);
-    setupComplexField(tmp_complex_field_["n0k"]);
     setupField(dphi_dn0_);
-    setupComplexField(dphi_dn0k_);
     setupField(n1_);
-    setupComplexField(tmp_complex_field_["n1k"]);
     setupField(dphi_dn1_);
-    setupComplexField(dphi_dn1k_);
     setupField(n2_);
-    setupComplexField(tmp_complex_field_["n2k"]);
     setupField(dphi_dn2_);
-    setupComplexField(dphi_dn2k_);
     setupField(n3_);
-    setupComplexField(tmp_complex_field_["n3k"]);
     setupField(dphi_dn3_);
-    setupComplexField(dphi_dn3k_);
     setupField(nv1_);
-    setupComplexField(tmp_complex_field_["nv1k"]);
     setupField(dphi_dnv1_);
-    setupComplexField(dphi_dnv1k_);
     setupField(nv2_);
-    setupComplexField(tmp_complex_field_["nv2k"]);
     setupField(dphi_dnv2_);
-    setupComplexField(dphi_dnv2k_);
-
-    // these two fields only exist in one space
     setupField(phi_);
-    setupComplexField(derivativek_);
+
+    if (symmetry == FourierTransform::Symmetry::periodic)
+        {
+        setupComplexField(tmp_complex_field_["n0k"]);
+        setupComplexField(tmp_complex_field_["n1k"]);
+        setupComplexField(tmp_complex_field_["n2k"]);
+        setupComplexField(tmp_complex_field_["n3k"]);
+        setupComplexField(tmp_complex_field_["nv1k"]);
+        setupComplexField(tmp_complex_field_["nv2k"]);
+        if (low_memory_)
+            {
+            // the weighted densities are back in real space before the derivatives of phi are
+            // transformed, so they can share reciprocal space
+            dphi_dn0k_ = tmp_complex_field_["n0k"];
+            dphi_dn1k_ = tmp_complex_field_["n1k"];
+            dphi_dn2k_ = tmp_complex_field_["n2k"];
+            dphi_dn3k_ = tmp_complex_field_["n3k"];
+            dphi_dnv1k_ = tmp_complex_field_["nv1k"];
+            dphi_dnv2k_ = tmp_complex_field_["nv2k"];
+            }
+        else
+            {
+            setupComplexField(dphi_dn0k_);
+            setupComplexField(dphi_dn1k_);
+            setupComplexField(dphi_dn2k_);
+            setupComplexField(dphi_dn3k_);
+            setupComplexField(dphi_dnv1k_);
+            setupComplexField(dphi_dnv2k_);
+            }
+        setupComplexField(derivativek_);
+        if (low_memory_)
+            {
+            // spherical meshes never transform the derivative, so it can hold the first vector
+            // phi derivative without the factor of r. the second one is read alongside all the
+            // other reciprocal fields in the type loop, so it needs its own storage.
+            tmp_complex_field_["dphi_dnv1k_unscaled"] = derivativek_;
+            }
+        tmp_coefficient_field_.clear();
+        }
+    else
+        {
+        // the real coefficients are set up as they are needed instead
+        dphi_dn0k_.reset();
+        dphi_dn1k_.reset();
+        dphi_dn2k_.reset();
+        dphi_dn3k_.reset();
+        dphi_dnv1k_.reset();
+        dphi_dnv2k_.reset();
+        derivativek_.reset();
+        tmp_complex_field_.clear();
+
+        if (low_memory_)
+            {
+            // the coefficients of the weighted densities are not needed once the derivatives of
+            // phi are transformed
+            if (conv_type == ConvolutionType::cartesian_cosine)
+                {
+                setupCoefficientField(tmp_coefficient_field_["n0"]);
+                setupCoefficientField(tmp_coefficient_field_["n1"]);
+                setupCoefficientField(tmp_coefficient_field_["n2"]);
+                setupCoefficientField(tmp_coefficient_field_["n3"]);
+                setupCoefficientField(tmp_coefficient_field_["nv1"]);
+                setupCoefficientField(tmp_coefficient_field_["nv2"]);
+                tmp_coefficient_field_["dphi_dn0"] = tmp_coefficient_field_["n0"];
+                tmp_coefficient_field_["dphi_dn1"] = tmp_coefficient_field_["n1"];
+                tmp_coefficient_field_["dphi_dn2"] = tmp_coefficient_field_["n2"];
+                tmp_coefficient_field_["dphi_dn3"] = tmp_coefficient_field_["n3"];
+                tmp_coefficient_field_["dphi_dnv1"] = tmp_coefficient_field_["nv1"];
+                tmp_coefficient_field_["dphi_dnv2"] = tmp_coefficient_field_["nv2"];
+                }
+            else
+                {
+                setupCoefficientField(tmp_coefficient_field_["n2"]);
+                setupCoefficientField(tmp_coefficient_field_["n3"]);
+                setupCoefficientField(tmp_coefficient_field_["dn3"]);
+                tmp_coefficient_field_["dphi_dn0"] = tmp_coefficient_field_["n2"];
+                tmp_coefficient_field_["dphi_dn1"] = tmp_coefficient_field_["n3"];
+                tmp_coefficient_field_["dphi_dn2"] = tmp_coefficient_field_["dn3"];
+                }
+            }
+        }
+
+    if (low_memory_)
+        {
+        // the spherical weighted densities of each type are accumulated before phi is evaluated,
+        // and the spherical derivatives are assembled after the weighted densities are used
+        tmp_field_["n2"] = dphi_dn2_;
+        tmp_field_["n3"] = dphi_dn3_;
+        tmp_field_["nv2"] = dphi_dnv2_;
+        tmp_field_["dF_dn0"] = n0_;
+        tmp_field_["dF_dn1"] = n1_;
+        tmp_field_["dF_dn2"] = n2_;
+        tmp_field_["dF_dn3"] = n3_;
+        tmp_field_["dF_dnv1"] = nv1_;
+        tmp_field_["dF_dnv2"] = nv2_;
+        }
 
     return compute;
     }
@@ -1070,19 +1664,31 @@ void RosenfeldFMT::setupField(std::shared_ptr<Field>& field)
     {
     if (!field)
         {
-        field = std::make_shared<Field>(ft_->getN() - 2 * buffer_shape_, buffer_shape_);
+        field = std::make_shared<Field>(shape_, buffer_shape_);
+        }
+    else
+        {
+        field->reshape(shape_, buffer_shape_);
+        }
+    }
+
+void RosenfeldFMT::setupComplexField(std::shared_ptr<ComplexField>& kfield)
+    {
+    if (!kfield)
+        {
+        kfield = std::make_shared<ComplexField>(ft_->getWavevectors().shape(), 0);
         }
     else
         {
-        field->reshape(ft_->getN() - 2 * buffer_shape_, buffer_shape_);
+        kfield->reshape(ft_->getWavevectors().shape(), 0);
         }
     }
 
-void RosenfeldFMT::setupComplexField(std::unique_ptr<ComplexField>& kfield)
+void RosenfeldFMT::setupCoefficientField(std::shared_ptr<Field>& kfield)
     {
     if (!kfield)
         {
-        kfield = std::make_unique<ComplexField>(ft_->getWavevectors().shape(), 0);
+        kfield = std::make_shared<Field>(ft_->getWavevectors().shape(), 0);
         }
     else
         {
@@ -1097,11 +1703,26 @@ RosenfeldFMT::getConvolutionType(std::shared_ptr<const Mesh> mesh) const
     ConvolutionType conv_type;
     if (dynamic_cast<const CartesianMesh*>(mesh_raw) != nullptr)
         {
-        conv_type = ConvolutionType::cartesian;
+        if (mesh->lower_boundary_condition() == BoundaryType::reflect
+            && mesh->upper_boundary_condition() == BoundaryType::reflect)
+            {
+            conv_type = ConvolutionType::cartesian_cosine;
+            }
+        else
+            {
+            conv_type = ConvolutionType::cartesian;
+            }
         }
     else if (dynamic_cast<const SphericalMesh*>(mesh_raw) != nullptr)
         {
-        conv_type = ConvolutionType::spherical;
+        if (mesh->lower_bound() == 0.)
+            {
+            conv_type = ConvolutionType::spherical_sine;
+            }
+        else
+            {
+            conv_type = ConvolutionType::spherical;
+            }
         }
     else
         {
@@ -1110,20 +1731,118 @@ RosenfeldFMT::getConvolutionType(std::shared_ptr<const Mesh> mesh) const
     return conv_type;
     }
 
+const RosenfeldFMT::OriginQuadrature&
+RosenfeldFMT::getOriginQuadrature(const std::string& type, const Mesh* mesh, double R)
+    {
+    // reuse the matrices while the radius and mesh are unchanged (R is never 0 for a valid entry)
+    auto& quad = origin_quadrature_[type];
+    if (quad.R == R && quad.lower_bound == mesh->lower_bound() && quad.step == mesh->step()
+        && quad.shape == mesh->shape())
+        {
+        return quad;
+        }
+    quad.R = R;
+    quad.lower_bound = mesh->lower_bound();
+    quad.step = mesh->step();
+    quad.shape = mesh->shape();
+
+    // the integrals run from 0 to r + R, and interpolation reads one bin past each end
+    quad.rows = std::min(mesh->bin(R), mesh->shape());
+    quad.first_column = mesh->bin(0.) - 1;
+    quad.columns = mesh->bin(mesh->center(quad.rows - 1) + R) + 2 - quad.first_column;
+    quad.w2.assign(quad.rows * quad.columns, 0.);
+    quad.w3.assign(quad.rows * quad.columns, 0.);
+    quad.wv2.assign(quad.rows * quad.columns, 0.);
+    quad.dwv2.assign(quad.rows * quad.columns, 0.);
+
+    // spread a quadrature weight onto the two bins that Mesh::interpolate reads at x
+    auto add = [&](std::vector<double>& w, int row, double x, double weight)
+    {
+        const int idx = mesh->bin(x);
+        const int idx_0 = (x < mesh->center(idx)) ? idx - 1 : idx;
+        const double x_0 = mesh->center(idx_0);
+        const double x_1 = mesh->center(idx_0 + 1);
+        const double frac = (x - x_0) / (x_1 - x_0);
+        w[row * quad.columns + idx_0 - quad.first_column] += (1. - frac) * weight;
+        w[row * quad.columns + idx_0 + 1 - quad.first_column] += frac * weight;
+    };
+
+    for (int idx = 0; idx < quad.rows; ++idx)
+        {
+        // take integrals using trapezoidal rule
+        const auto r = mesh->center(idx);
+
+        const double lower = 0;
+        const double split = R - r;
+        const double upper = r + R;
+
+        // integral from 0 to R-r
+        // we have found 100 points works well
+        const int n = 100;
+        double x = lower;
+        double dr = (split - lower) / n;
+        for (int ig_idx = 0; ig_idx <= n; ig_idx++)
+            {
+            const double factor = (ig_idx == 0 || ig_idx == n) ? 0.5 : 1.0;
+            add(quad.w3, idx, x, factor * dr * 4 * M_PI * x * x);
+            x += dr;
+            }
+
+        // Integral from R-r to r+R
+        x = split;
+        dr = (upper - split) / n;
+        for (int ig_idx = 0; ig_idx <= n; ig_idx++)
+            {
+            const double factor = (ig_idx == 0 || ig_idx == n) ? 0.5 : 1.0;
+            add(quad.w3, idx, x, factor * dr * (M_PI / r) * x * (R * R - (r - x) * (r - x)));
+            add(quad.w2, idx, x, factor * dr * (2. * M_PI * R / r) * x);
+            add(quad.wv2, idx, x, factor * dr * (M_PI / (r * r)) * x * (R * R + r * r - x * x));
+            add(quad.dwv2, idx, x, factor * dr * (M_PI / r) * (R * R - r * r + x * x));
+            x += dr;
+            }
+        }
+
+    return quad;
+    }
+
 void RosenfeldFMT::fourierTransformFieldSpherical(const Field::ConstantView& input,
-                                                  const Mesh* mesh) const
+                                                  const Mesh* mesh,
+                                                  bool multiply_r) const
     {
     auto tmp = tmp_r_field_->full_view();
     for (int idx = 0; idx < mesh->shape() + 2 * buffer_shape_; ++idx)
         {
         // r can't be negative, setting it to zero effectively throws this term out, as it should
         const auto r = std::max(mesh->center(idx - buffer_shape_), 0.);
-        tmp(idx) = r * input(idx);
+        if (multiply_r)
+            {
+            tmp(idx) = r * input(idx);
+            }
+        else
+            {
+            tmp(idx) = (r > 0.) ? input(idx) : 0.;
+            }
         }
     ft_->setRealData(tmp);
     ft_->transform();
     }
 
+void RosenfeldFMT::fourierTransformFieldRadial(FourierTransform& ft,
+                                               const Field::ConstantView& input,
+                                               const Mesh* mesh,
+                                               bool multiply_r)
+    {
+    // the transform covers the mesh and its upper buffer, starting from the origin
+    setupCoefficientField(tmp_coefficient_field_["r"]);
+    auto tmp = tmp_coefficient_field_["r"]->view();
+    for (int idx = 0; idx < ft.getN(); ++idx)
+        {
+        tmp(idx) = multiply_r ? mesh->center(idx) * input(idx) : input(idx);
+        }
+    ft.setRealData(tmp);
+    ft.transform();
+    }
+
 TypeMap<double>& RosenfeldFMT::getDiameters()
     {
     return diameters_;
@@ -1134,4 +1853,27 @@ const TypeMap<double>& RosenfeldFMT::getDiameters() const
     return diameters_;
     }
 
+bool RosenfeldFMT::getLowMemory() const
+    {
+    return low_memory_;
+    }
+
+void RosenfeldFMT::setLowMemory(bool low_memory)
+    {
+    if (low_memory != low_memory_)
+        {
+        // drop the scratch fields so that they are set up again with or without sharing
+        dphi_dn0k_.reset();
+        dphi_dn1k_.reset();
+        dphi_dn2k_.reset();
+        dphi_dn3k_.reset();
+        dphi_dnv1k_.reset();
+        dphi_dnv2k_.reset();
+        tmp_field_.clear();
+        tmp_complex_field_.clear();
+        tmp_coefficient_field_.clear();
+        low_memory_ = low_memory;
+        }
+    }
+
     } // namespace flyft
@@ -1,123 +1,440 @@
 #include "flyft/rpy_diffusive_flux.h"
 
+#include "flyft/cartesian_mesh.h"
+#include "flyft/indexed_type_map.h"
 #include "flyft/spherical_mesh.h"
 
+#include <algorithm>
+#include <cmath>
 #include <exception>
+#include <limits>
+#include <vector>
 
 namespace flyft
     {
 
-RPYDiffusiveFlux::RPYDiffusiveFlux() : viscosity_(1.0) {}
+/* The mobility kernel M(x,y) is a polynomial in z = y - x for both geometries, so its integral
+against rho*dmu over any range of y can be taken from a few moments of rho*dmu in z. The
+functions below are overloaded on the mesh type to supply the geometry-specific parts.
 
-void RPYDiffusiveFlux::compute(std::shared_ptr<GrandPotential> grand, std::shared_ptr<State> state)
+In spherical geometry, M = prefactor * (d-x-y)(d+x-y)(d-x+y)(d+x+y), which is
+prefactor * (d^2 - z^2)(d^2 - (2x+z)^2), a quartic in z.
+
+In Cartesian geometry, the laterally averaged kernel is the planar limit of the spherical one
+(x, y -> infinity at fixed z), M = -(a_i^2 + 3 a_i a_j + a_j^2) (d^2 - z^2) / (6 eta d^3) for
+|z| < d, a quadratic in z.
+
+Taking the moments about a fixed origin and expanding the kernel about it cancels badly once x is
+much larger than d. Instead, the moments are summed over blocks of bins about the start of each
+block, and the partial sums of the blocks in a window are shifted to be about x, so every term
+stays on the scale of d. */
+
+//! Check if the flux on the lower edge of a bin is zero by symmetry
+static bool isSymmetryPoint(double x, const SphericalMesh* /*mesh*/)
     {
-    setup(grand, state);
+    /* Considering symmetry about the center of the sphere and concentration gradient
+    along the radial direction only, the flux at the center of the sphere is 0, i.e.
+    density flux going into the center is equal to density flux out of the center.
+    If this condition is not met, the symmetry assumption would be violated.*/
+    return x == 0;
+    }
 
-    auto excess = grand->getExcessFunctional();
-    auto external = grand->getExternalPotential();
-    if (excess)
+static bool isSymmetryPoint(double /*x*/, const CartesianMesh* /*mesh*/)
+    {
+    return false;
+    }
+
+//! Range of bins [low, high) whose lower edges are within a distance d of x
+static void calculateIntegrationLimits(double x,
+                                       double d,
+                                       const SphericalMesh* mesh,
+                                       int& low,
+                                       int& high)
+    {
+    // To remove the concern about the lower bound value spill over the buffer sites
+    low = std::ceil((std::abs(x - d) - mesh->lower_bound()) / mesh->step());
+    high = mesh->bin(x + d);
+    }
+
+static void calculateIntegrationLimits(double x,
+                                       double d,
+                                       const CartesianMesh* mesh,
+                                       int& low,
+                                       int& high)
+    {
+    // x is always a lower edge, so offset its index by whole bins to keep the window the same
+    // shape at every edge instead of rounding x - d and x + d separately
+    const int edge = static_cast<int>(std::lround((x - mesh->lower_bound()) / mesh->step()));
+    const double reach = d / mesh->step();
+    low = edge + static_cast<int>(std::ceil(-reach));
+    high = edge + static_cast<int>(std::floor(reach));
+    }
+
+//! Highest power of z in the mobility kernel
+static int kernelDegree(const SphericalMesh* /*mesh*/)
+    {
+    return 4;
+    }
+
+static int kernelDegree(const CartesianMesh* /*mesh*/)
+    {
+    return 2;
+    }
+
+//! Integral of the mobility kernel times rho*dmu from the moments in z = y - x
+static double integrateMobility(double x,
+                                double d,
+                                double c,
+                                double viscosity,
+                                const double* T,
+                                const SphericalMesh* /*mesh*/)
+    {
+    const double x2 = x * x;
+    const double d2 = d * d;
+    const double prefactor = c / (24 * x2 * viscosity * d2 * d);
+    const double A = d2 - 4 * x2;
+    return prefactor
+           * (d2 * A * T[0] - 4 * x * d2 * T[1] - (d2 + A) * T[2] + 4 * x * T[3] + T[4]);
+    }
+
+static double integrateMobility(double /*x*/,
+                                double d,
+                                double c,
+                                double viscosity,
+                                const double* T,
+                                const CartesianMesh* /*mesh*/)
+    {
+    const double prefactor = -c / (6 * viscosity * d * d * d);
+    return prefactor * (d * d * T[0] - T[2]);
+    }
+
+//! Maximum number of moments of rho*dmu for any geometry
+static constexpr int max_moments = 5;
+
+//! Block-wise prefix sums of the moments of rho*dmu for one type
+/*!
+ * The bins [first, last) are split into blocks of a fixed number of bins. For each block, the sums
+ * of rho*dmu*(y-o)^k over its first m bins are stored, where o is the lower edge of the block, so
+ * the sums restart at zero at the start of every block.
+ */
+struct RPYMoments
+    {
+    int first;                          //!< First bin in the sums
+    int block;                          //!< Number of bins per block
+    int num_moments;                    //!< Number of moments summed
+    std::vector<double> s[max_moments]; //!< Prefix sums, block + 1 entries per block
+    };
+
+//! Sum the moments of rho*dmu in z = y - x over bins [low, high)
+template<class MeshType>
+static void
+sumMoments(const RPYMoments& m, int low, int high, double x, const MeshType* mesh, double* T)
+    {
+    for (int k = 0; k < m.num_moments; ++k)
         {
-        excess->compute(state, false);
+        T[k] = 0.;
         }
-    if (external)
+
+    const int stride = m.block + 1;
+    const int first_block = (low - m.first) / m.block;
+    const int last_block = (high - 1 - m.first) / m.block;
+    for (int b = first_block; b <= last_block; ++b)
         {
-        external->compute(state, false);
+        const int block_first = m.first + b * m.block;
+        const int lo = std::max(low, block_first) - block_first;
+        const int hi = std::min(high, block_first + m.block) - block_first;
+
+        // partial sums about the start of the block
+        double P[max_moments];
+        for (int k = 0; k < m.num_moments; ++k)
+            {
+            P[k] = m.s[k][b * stride + hi] - m.s[k][b * stride + lo];
+            }
+
+        // shift to be about x with the binomial expansion of (y - o + h)^k
+        const double h = mesh->lower_bound(block_first) - x;
+        for (int k = 0; k < m.num_moments; ++k)
+            {
+            double binomial = 1.;
+            double h_power = 1.;
+            double Pk = 0.;
+            for (int j = k; j >= 0; --j)
+                {
+                Pk += binomial * h_power * P[j];
+                binomial *= static_cast<double>(j) / (k - j + 1);
+                h_power *= h;
+                }
+            T[k] += Pk;
+            }
         }
-    state->syncFields();
+    }
 
-    // compute fluxes on the left edge of the volumes (exclude the first point)
-    const auto mesh = state->getMesh()->local().get();
-    if (!dynamic_cast<const SphericalMesh*>(mesh))
+//! Total flux of type i on the lower edge of bin idx from all types
+template<class MeshType>
+static double calculateFlux(int idx,
+                            int i,
+                            double viscosity,
+                            const IndexedTypeMap<double>& diameters,
+                            const IndexedTypeMap<Field::ConstantView>& rhos,
+                            const IndexedTypeMap<Field::ConstantView>& mu_exs,
+                            const IndexedTypeMap<Field::ConstantView>& Vs,
+                            const IndexedTypeMap<RPYMoments>& moments,
+                            const MeshType* mesh)
+    {
+    const auto x = mesh->lower_bound(idx);
+    if (isSymmetryPoint(x, mesh))
         {
-        throw std::invalid_argument("Spherical geometry required");
+        return 0.;
         }
 
-    for (const auto& i : state->getTypes())
+    const double a_i = 0.5 * diameters(i);
+    const auto rho_x = mesh->interpolate(x, rhos(i));
+    double flux = 0.;
+
+    // BD flux calculation
+    const double D_i = 1 / (6 * M_PI * viscosity * a_i);
+    auto dmu_ex = 0.0;
+    if (mu_exs(i))
+        dmu_ex += mesh->gradient(idx, mu_exs(i));
+    if (Vs(i))
+        dmu_ex += mesh->gradient(idx, Vs(i));
+    flux += -D_i * (mesh->gradient(idx, rhos(i)) + rho_x * dmu_ex);
+
+    // RPY flux calculation from all species
+    for (int j = 0; j < diameters.size(); ++j)
+        {
+        const double a_j = 0.5 * diameters(j);
+        const double d_ij = a_i + a_j;
+        int ig_low, ig_high;
+        calculateIntegrationLimits(x, d_ij, mesh, ig_low, ig_high);
+        if (ig_low >= ig_high)
+            {
+            continue;
+            }
+
+        double T[max_moments];
+        sumMoments(moments(j), ig_low, ig_high, x, mesh, T);
+        const double c = a_i * a_i + 3 * a_i * a_j + a_j * a_j;
+        flux += -rho_x * integrateMobility(x, d_ij, c, viscosity, T, mesh) * mesh->step();
+        }
+
+    return flux;
+    }
+
+template<class MeshType>
+static void calculateFluxes(std::shared_ptr<State> state,
+                            double viscosity,
+                            const IndexedTypeMap<double>& diameters,
+                            const IndexedTypeMap<Field::ConstantView>& rhos,
+                            const IndexedTypeMap<Field::ConstantView>& mu_exs,
+                            const IndexedTypeMap<Field::ConstantView>& Vs,
+                            const TypeMap<std::shared_ptr<Field>>& fluxes,
+                            const MeshType* mesh)
+    {
+    const auto& types = state->getTypes();
+    const int num_types = static_cast<int>(types.size());
+
+    // find the range of y that is needed for each type, then accumulate the moments over it
+    IndexedTypeMap<RPYMoments> moments(num_types);
+    for (int j = 0; j < num_types; ++j)
         {
-        const double a_i = 0.5 * diameters_(i);
-        auto rho_i = state->getField(i)->const_view();
-        auto flux_i = fluxes_(i)->view();
-        const double D_i = 1 / (6 * M_PI * viscosity_ * a_i);
-
-        // fill flux with zeros initially
-        std::fill(flux_i.begin(), flux_i.end(), 0.);
-
-        // RPY flux from all species
-        for (const auto& j : state->getTypes())
-            {
-            const double a_j = 0.5 * diameters_(j);
-            auto rho_j = state->getField(j)->const_view();
-            auto mu_ex_j
-                = (excess) ? excess->getDerivative(j)->const_view() : Field::ConstantView();
-            auto V_j
-                = (external) ? external->getDerivative(j)->const_view() : Field::ConstantView();
+        int first = std::numeric_limits<int>::max();
+        int last = std::numeric_limits<int>::lowest();
+        for (int i = 0; i < num_types; ++i)
+            {
+            const double d_ij = 0.5 * (diameters(i) + diameters(j));
             for (int idx = 0; idx < mesh->shape(); ++idx)
                 {
                 const auto x = mesh->lower_bound(idx);
-
-                /* Considering symmetry about the center of the sphere and concentration gradient
-                along the radial direction only, the flux at the center of the sphere is 0, i.e.
-                density flux going into the center is equal to density flux out of the center.
-                If this condition is not met, the symmetry assumption would be violated.*/
-
-                if (x == 0)
+                if (isSymmetryPoint(x, mesh))
                     {
                     continue;
                     }
-                auto rho_x = mesh->interpolate(x, rho_i);
-                // BD flux calculation
-                if (i == j)
+                int ig_low, ig_high;
+                calculateIntegrationLimits(x, d_ij, mesh, ig_low, ig_high);
+                if (ig_low < ig_high)
                     {
-                    auto dmu_ex = 0.0;
-                    if (mu_ex_j)
-                        dmu_ex += mesh->gradient(idx, mu_ex_j);
-                    if (V_j)
-                        {
-                        if (std::isinf(V_j(idx)))
-                            {
-                            throw std::invalid_argument(
-                                "RPY is incompatible with infinite potentials");
-                            }
-                        dmu_ex += mesh->gradient(idx, V_j);
-                        }
-                    flux_i(idx) += -D_i * (mesh->gradient(idx, rho_j) + rho_x * dmu_ex);
+                    first = std::min(first, ig_low);
+                    last = std::max(last, ig_high);
                     }
+                }
+            }
+        if (first > last)
+            {
+            first = last = 0;
+            }
+
+        // check for infinite potentials up front, since the loops below cannot throw
+        auto V_j = Vs(j);
+        if (V_j)
+            {
+            for (int idx = std::min(first, 0) - 1; idx < std::max(last, mesh->shape()); ++idx)
+                {
+                if (std::isinf(V_j(idx)))
+                    {
+                    throw std::invalid_argument("RPY is incompatible with infinite potentials");
+                    }
+                }
+            }
+
+        // split the range into blocks no wider than the narrowest window
+        int block = std::numeric_limits<int>::max();
+        for (int i = 0; i < num_types; ++i)
+            {
+            block = std::min(block, mesh->asShape(0.5 * (diameters(i) + diameters(j))));
+            }
+        block = std::max(block, 1);
+        const int num_blocks = (last - first + block - 1) / block;
+
+        auto& m = moments[j];
+        m.first = first;
+        m.block = block;
+        m.num_moments = kernelDegree(mesh) + 1;
+        for (int k = 0; k < max_moments; ++k)
+            {
+            m.s[k].assign((k < m.num_moments) ? num_blocks * (block + 1) : 0, 0.);
+            }
+
+        // total gradient of chemical potential on the lower edge of each bin
+        auto rho_j = rhos(j);
+        auto mu_ex_j = mu_exs(j);
+        std::vector<double> rho_dmus(last - first);
+        double* rho_dmu = rho_dmus.data();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) firstprivate(first, last, mesh, rho_dmu) \
+    shared(rho_j, mu_ex_j, V_j)
+#endif
+        for (int ig_idx = first; ig_idx < last; ++ig_idx)
+            {
+            const auto y = mesh->lower_bound(ig_idx);
+            double dmu = mesh->gradient(ig_idx, rho_j);
+            auto rho_y = mesh->interpolate(y, rho_j);
+            if (mu_ex_j)
+                dmu += rho_y * mesh->gradient(ig_idx, mu_ex_j);
+            if (V_j)
+                dmu += rho_y * mesh->gradient(ig_idx, V_j);
+            rho_dmu[ig_idx - first] = dmu;
+            }
 
-                // RPY flux calculation
-                const double d_ij = a_i + a_j;
-
-                // To remove the concern about the lower bound value spill over the buffer sites
-                const int ig_low
-                    = std::ceil((std::abs(x - d_ij) - mesh->lower_bound()) / mesh->step());
-                const int ig_high = mesh->bin(x + d_ij);
-                double ig = 0.;
-                const double prefactor = (a_i * a_i + 3 * a_i * a_j + a_j * a_j)
-                                         / (24 * x * x * viscosity_ * d_ij * d_ij * d_ij);
-                for (int ig_idx = ig_low; ig_idx < ig_high; ++ig_idx)
+        // prefix sums of the moments within each block, about the lower edge of the block
+        const int num_moments = m.num_moments;
+        double* s0 = m.s[0].data();
+        double* s1 = m.s[1].data();
+        double* s2 = m.s[2].data();
+        double* s3 = m.s[3].data();
+        double* s4 = m.s[4].data();
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) \
+    firstprivate(first, last, block, num_blocks, num_moments, mesh, rho_dmu, s0, s1, s2, s3, s4)
+#endif
+        for (int b = 0; b < num_blocks; ++b)
+            {
+            double* s[max_moments] = {s0, s1, s2, s3, s4};
+            double sums[max_moments] = {0., 0., 0., 0., 0.};
+            const int block_first = first + b * block;
+            const int block_last = std::min(block_first + block, last);
+            const auto origin = mesh->lower_bound(block_first);
+            for (int ig_idx = block_first; ig_idx < block_last; ++ig_idx)
+                {
+                const double z = mesh->lower_bound(ig_idx) - origin;
+                const int offset = b * (block + 1) + (ig_idx - block_first) + 1;
+                double moment = rho_dmu[ig_idx - first];
+                for (int k = 0; k < num_moments; ++k)
                     {
-                    const auto y = mesh->lower_bound(ig_idx);
-                    // total gradient of chemical potential
-                    double rho_dmu = mesh->gradient(ig_idx, rho_j);
-                    auto rho_y = mesh->interpolate(y, rho_j);
-                    if (mu_ex_j)
-                        rho_dmu += rho_y * mesh->gradient(ig_idx, mu_ex_j);
-                    if (V_j)
-                        rho_dmu += rho_y * mesh->gradient(ig_idx, V_j);
-
-                    const double M = prefactor * (d_ij - x - y) * (d_ij + x - y) * (d_ij - x + y)
-                                     * (d_ij + x + y);
-                    ig += M * rho_dmu;
+                    sums[k] += moment;
+                    s[k][offset] = sums[k];
+                    moment *= z;
                     }
-                flux_i(idx) += -rho_x * ig * mesh->step();
                 }
             }
-        state->getMesh()->startSync(fluxes_(i));
+        }
+
+    for (int i = 0; i < num_types; ++i)
+        {
+        auto flux_i = fluxes(types[i])->view();
+
+        // compute flux on edges and start sending, including the edge that a reflecting lower
+        // boundary mirrors into the buffer
+        const int flux_buffer = fluxes(types[i])->buffer_shape();
+        const int lower_edge = std::min(flux_buffer + 1, mesh->shape() - flux_buffer);
+        for (int idx = 0; idx < lower_edge; ++idx)
+            {
+            flux_i(idx)
+                = calculateFlux(idx, i, viscosity, diameters, rhos, mu_exs, Vs, moments, mesh);
+            }
+        for (int idx = mesh->shape() - flux_buffer; idx < mesh->shape(); ++idx)
+            {
+            flux_i(idx)
+                = calculateFlux(idx, i, viscosity, diameters, rhos, mu_exs, Vs, moments, mesh);
+            }
+        state->getMesh()->startSync(fluxes(types[i]));
+
+// compute flux on interior points
+#ifdef FLYFT_OPENMP
+#pragma omp parallel for schedule(static) default(none) \
+    firstprivate(i, viscosity, mesh, flux_buffer, lower_edge) \
+    shared(diameters, rhos, mu_exs, Vs, moments, flux_i)
+#endif
+        for (int idx = lower_edge; idx < mesh->shape() - flux_buffer; ++idx)
+            {
+            flux_i(idx)
+                = calculateFlux(idx, i, viscosity, diameters, rhos, mu_exs, Vs, moments, mesh);
+            }
         }
 
     // finalize all flux communication
-    for (const auto& i : state->getTypes())
+    for (const auto& t : types)
         {
-        state->getMesh()->endSync(fluxes_(i));
+        state->getMesh()->endSync(fluxes(t));
+        }
+    }
+
+RPYDiffusiveFlux::RPYDiffusiveFlux() : viscosity_(1.0)
+    {
+    compute_depends_.add(&diameters_);
+    }
+
+void RPYDiffusiveFlux::_compute(std::shared_ptr<GrandPotential> grand,
+                                std::shared_ptr<State> state)
+    {
+    // functionals have already been evaluated and synced by setup
+    auto excess = grand->getExcessFunctional();
+    auto external = grand->getExternalPotential();
+
+    // process maps into indexed arrays for quicker access inside loop
+    const auto& types = state->getTypes();
+    const int num_types = static_cast<int>(types.size());
+    const IndexedTypeMap<double> diameters(types, diameters_);
+    IndexedTypeMap<Field::ConstantView> rhos(num_types);
+    IndexedTypeMap<Field::ConstantView> mu_exs(num_types);
+    IndexedTypeMap<Field::ConstantView> Vs(num_types);
+    for (int j = 0; j < num_types; ++j)
+        {
+        rhos[j] = state->getField(types[j])->const_view();
+        if (excess)
+            {
+            mu_exs[j] = excess->getDerivative(types[j])->const_view();
+            }
+        if (external)
+            {
+            Vs[j] = external->getDerivative(types[j])->const_view();
+            }
+        }
+
+    // compute fluxes on the left edge of the volumes (exclude the first point), using the concrete
+    // mesh type so that its geometry is inlined in the loops
+    const auto mesh = state->getMesh()->local().get();
+    if (auto spherical = dynamic_cast<const SphericalMesh*>(mesh))
+        {
+        calculateFluxes(state, viscosity_, diameters, rhos, mu_exs, Vs, fluxes_, spherical);
+        }
+    else if (auto cartesian = dynamic_cast<const CartesianMesh*>(mesh))
+        {
+        calculateFluxes(state, viscosity_, diameters, rhos, mu_exs, Vs, fluxes_, cartesian);
+        }
+    else
+        {
+        throw std::invalid_argument("Spherical or Cartesian geometry required");
         }
     }
 
@@ -142,7 +459,11 @@ void RPYDiffusiveFlux::setViscosity(double viscosity)
         {
         throw std::invalid_argument("Viscosity must be positive");
         }
-    viscosity_ = viscosity;
+    if (viscosity != viscosity_)
+        {
+        viscosity_ = viscosity;
+        token_.stageAndCommit();
+        }
     }
 
 int RPYDiffusiveFlux::determineBufferShape(std::shared_ptr<State> state, const std::string& type)
@@ -157,6 +478,8 @@ int RPYDiffusiveFlux::determineBufferShape(std::shared_ptr<State> state, const s
             max_diameter = d_i;
             }
         }
-    return mesh->asShape(0.5 * (diameters_(type) + max_diameter));
+    // the integration can reach a full contact distance below the lowest edge, and the gradient
+    // and interpolation at that edge read one point further
+    return mesh->asShape(0.5 * (diameters_(type) + max_diameter)) + 1;
     }
     } // namespace flyft
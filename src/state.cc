@@ -1,7 +1,8 @@
 #include "flyft/state.h"
 
 #include <algorithm>
-#include <cmath>
+#include <stdexcept>
+#include <utility>
 
 namespace flyft
     {
@@ -14,6 +15,13 @@ State::State(std::shared_ptr<ParallelMesh> mesh, const std::string& type)
 State::State(std::shared_ptr<ParallelMesh> mesh, const std::vector<std::string>& types)
     : mesh_(mesh), types_(types), time_(0)
     {
+    for (int i = 0; i < static_cast<int>(types_.size()); ++i)
+        {
+        if (!type_indexes_.emplace(types_[i], i).second)
+            {
+            throw std::invalid_argument("Types must be unique");
+            }
+        }
     for (const auto& t : types_)
         {
         fields_[t] = std::make_shared<Field>(mesh_->local()->shape());
@@ -22,7 +30,8 @@ State::State(std::shared_ptr<ParallelMesh> mesh, const std::vector<std::string>&
     }
 
 State::State(const State& other)
-    : TrackedObject(other), mesh_(other.mesh_), types_(other.types_), time_(other.time_)
+    : TrackedObject(other), mesh_(other.mesh_), types_(other.types_),
+      type_indexes_(other.type_indexes_), time_(other.time_)
     {
     for (const auto& t : types_)
         {
@@ -37,7 +46,8 @@ State::State(const State& other)
 
 State::State(State&& other)
     : TrackedObject(other), mesh_(std::move(other.mesh_)), types_(std::move(other.types_)),
-      fields_(std::move(other.fields_)), time_(std::move(other.time_))
+      type_indexes_(std::move(other.type_indexes_)), fields_(std::move(other.fields_)),
+      time_(std::move(other.time_))
     {
     }
 
@@ -48,6 +58,7 @@ State& State::operator=(const State& other)
         TrackedObject::operator=(other);
         mesh_ = other.mesh_;
         types_ = other.types_;
+        type_indexes_ = other.type_indexes_;
         time_ = other.time_;
 
         // match field types and buffer shapes
@@ -77,11 +88,32 @@ State& State::operator=(State&& other)
     TrackedObject::operator=(other);
     mesh_ = std::move(other.mesh_);
     types_ = std::move(other.types_);
+    type_indexes_ = std::move(other.type_indexes_);
     fields_ = std::move(other.fields_);
     time_ = std::move(other.time_);
     return *this;
     }
 
+void State::swap(State& other)
+    {
+    if (this == &other)
+        {
+        return;
+        }
+    if (mesh_ != other.mesh_ || types_ != other.types_)
+        {
+        throw std::invalid_argument("States must have the same mesh and types to swap");
+        }
+
+    std::swap(time_, other.time_);
+    for (const auto& t : types_)
+        {
+        fields_[t]->swap(*other.fields_[t]);
+        }
+    token_.stageAndCommit();
+    other.token_.stageAndCommit();
+    }
+
 std::shared_ptr<ParallelMesh> State::getMesh()
     {
     return mesh_;
@@ -119,12 +151,12 @@ const std::string State::getType(int idx) const
 
 int State::getTypeIndex(const std::string& type) const
     {
-    const auto it = std::find(types_.begin(), types_.end(), type);
-    if (it == types_.end())
+    const auto it = type_indexes_.find(type);
+    if (it == type_indexes_.end())
         {
-        // error: type not found
+        throw std::invalid_argument("Type not found");
         }
-    return (it - types_.begin());
+    return it->second;
     }
 
 const TypeMap<std::shared_ptr<Field>>& State::getFields()
@@ -187,7 +219,7 @@ void State::startSyncFields(const TypeMap<std::shared_ptr<Field>>& fields) const
     {
     for (auto it = fields.cbegin(); it != fields.cend(); ++it)
         {
-        if (std::find(types_.begin(), types_.end(), it->first) == types_.end())
+        if (type_indexes_.find(it->first) == type_indexes_.end())
             {
             // ERROR: types do not match
             }
@@ -202,7 +234,7 @@ void State::endSyncFields(const TypeMap<std::shared_ptr<Field>>& fields) const
     {
     for (auto it = fields.cbegin(); it != fields.cend(); ++it)
         {
-        if (std::find(types_.begin(), types_.end(), it->first) == types_.end())
+        if (type_indexes_.find(it->first) == type_indexes_.end())
             {
             // ERROR: types do not match
             }
@@ -230,7 +262,7 @@ void State::matchFields(TypeMap<std::shared_ptr<Field>>& fields,
     for (auto it = fields.cbegin(); it != fields.cend(); /* no increment here */)
         {
         const auto t = it->first;
-        if (std::find(types_.begin(), types_.end(), t) == types_.end())
+        if (type_indexes_.find(t) == type_indexes_.end())
             {
             it = fields.erase(it);
             }
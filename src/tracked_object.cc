@@ -5,7 +5,7 @@
 
 namespace flyft
     {
-TrackedObject::Identifier TrackedObject::count = 0;
+std::atomic<TrackedObject::Identifier> TrackedObject::count(0);
 
 TrackedObject::TrackedObject() : id_(count++), token_(id_) {}
 
@@ -1,5 +1,8 @@
 #include "flyft/virial_expansion.h"
 
+#include "flyft/indexed_pair_map.h"
+#include "flyft/indexed_type_map.h"
+
 #include <algorithm>
 
 namespace flyft
@@ -38,33 +41,41 @@ static void computeFunctional(int idx,
 
 void VirialExpansion::_compute(std::shared_ptr<State> state, bool compute_value)
     {
-    auto types = state->getTypes();
+    const auto& types = state->getTypes();
+    const int num_types = static_cast<int>(types.size());
     const auto mesh = state->getMesh()->local().get();
 
+    // process maps into indexed arrays for quicker access inside loop
+    const IndexedPairMap<double> coeffs(types, coeffs_);
+    IndexedTypeMap<Field::ConstantView> fields(num_types);
+    IndexedTypeMap<Field::View> derivs(num_types);
+
     // reset energy and chemical potentials to zero before accumulating
     value_ = 0.0;
     int max_deriv_buffer = 0;
-    for (const auto& t : types)
+    for (int i = 0; i < num_types; ++i)
         {
-        std::fill(derivatives_(t)->view().begin(), derivatives_(t)->view().end(), 0.);
-        max_deriv_buffer = std::max(max_deriv_buffer, derivatives_(t)->buffer_shape());
+        fields[i] = state->getField(types[i])->const_view();
+        derivs[i] = derivatives_(types[i])->view();
+        std::fill(derivs[i].begin(), derivs[i].end(), 0.);
+        max_deriv_buffer = std::max(max_deriv_buffer, derivatives_(types[i])->buffer_shape());
         }
 
-    // begin calculation on edges and send
-    for (auto it_i = types.cbegin(); it_i != types.cend(); ++it_i)
+    // begin calculation on edges and send, including the point that a reflecting lower boundary
+    // mirrors into the buffer
+    const int lower_edge = std::min(max_deriv_buffer + 1, mesh->shape() - max_deriv_buffer);
+    for (int i = 0; i < num_types; ++i)
         {
-        const auto i = *it_i;
-        auto fi = state->getField(i)->const_view();
-        auto di = derivatives_(i)->view();
+        auto fi = fields(i);
+        auto di = derivs(i);
 
-        for (auto it_j = it_i; it_j != types.cend(); ++it_j)
+        for (int j = i; j < num_types; ++j)
             {
-            const auto j = *it_j;
-            auto fj = state->getField(j)->const_view();
-            auto dj = derivatives_(j)->view();
+            auto fj = fields(j);
+            auto dj = derivs(j);
 
-            const double Bij = coeffs_(i, j);
-            for (int idx = 0; idx < max_deriv_buffer; ++idx)
+            const double Bij = coeffs(i, j);
+            for (int idx = 0; idx < lower_edge; ++idx)
                 {
                 computeFunctional(idx, di, dj, value_, fi, fj, Bij, mesh, compute_value);
                 }
@@ -75,28 +86,26 @@ void VirialExpansion::_compute(std::shared_ptr<State> state, bool compute_value)
             }
 
         // all the contributions to this type are done, so start syncing
-        state->getMesh()->startSync(derivatives_(i));
+        state->getMesh()->startSync(derivatives_(types[i]));
         }
 
     // calculate on interior points
-    for (auto it_i = types.cbegin(); it_i != types.cend(); ++it_i)
+    for (int i = 0; i < num_types; ++i)
         {
-        const auto i = *it_i;
-        auto fi = state->getField(i)->const_view();
-        auto di = derivatives_(i)->view();
+        auto fi = fields(i);
+        auto di = derivs(i);
 
-        for (auto it_j = it_i; it_j != types.cend(); ++it_j)
+        for (int j = i; j < num_types; ++j)
             {
-            const auto j = *it_j;
-            auto fj = state->getField(j)->const_view();
-            auto dj = derivatives_(j)->view();
+            auto fj = fields(j);
+            auto dj = derivs(j);
 
-            const double Bij = coeffs_(i, j);
+            const double Bij = coeffs(i, j);
 #ifdef FLYFT_OPENMP
-#pragma omp parallel for schedule(static) default(none) firstprivate(Bij, mesh) \
+#pragma omp parallel for schedule(static) default(none) firstprivate(Bij, mesh, lower_edge) \
     shared(fi, di, fj, dj, compute_value, max_deriv_buffer) reduction(+ : value_)
 #endif
-            for (int idx = max_deriv_buffer; idx < mesh->shape() - max_deriv_buffer; ++idx)
+            for (int idx = lower_edge; idx < mesh->shape() - max_deriv_buffer; ++idx)
                 {
                 computeFunctional(idx, di, dj, value_, fi, fj, Bij, mesh, compute_value);
                 }